@@ -0,0 +1,480 @@
+#pragma once
+
+#include <arba/core/bit/load_store.hpp>
+#include <arba/core/simd/simd_dispatcher.hpp>
+#include <arba/cppx/policy/exception_policy.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief The bit_order enum tells in which order the bits of a byte are consumed by bit streams.
+ *
+ * With msb_first, fields are stored from the most significant bit of the first byte (network order, as in most
+ * codecs). With lsb_first, they are stored from its least significant bit (as in deflate).
+ */
+enum class bit_order : uint8_t
+{
+    msb_first,
+    lsb_first
+};
+
+namespace private_
+{
+// Number of bits which can always be read from, or written to, a 64-bit buffer holding a partial byte.
+inline constexpr unsigned max_buffered_field_size_ = 56;
+
+template <bit_order Order>
+inline constexpr std::endian bit_stream_word_endianness_
+    = Order == bit_order::msb_first ? std::endian::big : std::endian::little;
+
+[[nodiscard]] inline constexpr uint64_t low_bits_mask_(unsigned nb_bits)
+{
+    return nb_bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << nb_bits) - 1;
+}
+
+// Returns the nb_bits bits (at most 57) stored from bit_position. Missing bytes past size read as zeros.
+template <bit_order Order>
+[[nodiscard]] inline uint64_t extract_bits_(const std::byte* data, std::size_t size, std::size_t bit_position,
+                                            unsigned nb_bits)
+{
+    const std::size_t byte_position = bit_position / 8;
+    const unsigned shift = bit_position % 8;
+    uint64_t word = 0;
+    if (size >= sizeof(uint64_t) && byte_position <= size - sizeof(uint64_t)) [[likely]]
+        word = load_<bit_stream_word_endianness_<Order>, uint64_t>(data + byte_position);
+    else
+    {
+        for (std::size_t i = 0; byte_position + i < size; ++i)
+        {
+            const uint64_t byte = static_cast<uint8_t>(data[byte_position + i]);
+            word |= Order == bit_order::msb_first ? byte << (56 - 8 * i) : byte << (8 * i);
+        }
+    }
+    if constexpr (Order == bit_order::msb_first)
+        return ((word << shift) >> 1) >> (63 - nb_bits);
+    else
+        return (word >> shift) & low_bits_mask_(nb_bits);
+}
+
+template <bit_order Order, std::unsigned_integral T>
+inline void unpack_bits_scalar_(const std::byte* data, std::size_t size, std::size_t bit_position, unsigned nb_bits,
+                                T* output, std::size_t count)
+{
+    if (nb_bits <= max_buffered_field_size_ + 1)
+    {
+        for (std::size_t i = 0; i < count; ++i, bit_position += nb_bits)
+            output[i] = static_cast<T>(extract_bits_<Order>(data, size, bit_position, nb_bits));
+    }
+    else
+    {
+        const unsigned nb_high_bits = nb_bits - 32;
+        const std::size_t high_bits_offset = Order == bit_order::msb_first ? 0 : 32;
+        const std::size_t low_bits_offset = Order == bit_order::msb_first ? nb_high_bits : 0;
+        for (std::size_t i = 0; i < count; ++i, bit_position += nb_bits)
+        {
+            const uint64_t high_bits = extract_bits_<Order>(data, size, bit_position + high_bits_offset, nb_high_bits);
+            const uint64_t low_bits = extract_bits_<Order>(data, size, bit_position + low_bits_offset, 32);
+            output[i] = static_cast<T>(high_bits << 32 | low_bits);
+        }
+    }
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+// Unpacks 8 fields of up to 25 bits per iteration: each lane gathers the 4 bytes holding its field, then shifts
+// and masks it.
+template <bit_order Order, std::unsigned_integral T>
+ARBA_CORE_TARGET("avx2")
+inline void unpack_bits_avx2_(const std::byte* data, std::size_t size, std::size_t bit_position, unsigned nb_bits,
+                              T* output, std::size_t count)
+{
+    std::size_t nb_done = 0;
+    if (nb_bits > 0 && nb_bits <= 25)
+    {
+        const int field_size = static_cast<int>(nb_bits);
+        const __m256i lane_bit_offsets
+            = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(field_size));
+        const __m256i seven = _mm256_set1_epi32(7);
+        const __m256i value_mask = _mm256_set1_epi32(static_cast<int>(low_bits_mask_(nb_bits)));
+        const __m128i value_shift = _mm_cvtsi32_si128(32 - field_size);
+        const __m256i big_endian_mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2,
+                                                         1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (; count - nb_done >= 8 && (bit_position + 7 * nb_bits) / 8 + 4 <= size;
+             nb_done += 8, bit_position += 8 * nb_bits)
+        {
+            const __m256i bit_offsets
+                = _mm256_add_epi32(lane_bit_offsets, _mm256_set1_epi32(static_cast<int>(bit_position % 8)));
+            const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data + bit_position / 8),
+                                                         _mm256_srli_epi32(bit_offsets, 3), 1);
+            const __m256i shifts = _mm256_and_si256(bit_offsets, seven);
+            __m256i values;
+            if constexpr (Order == bit_order::msb_first)
+                values = _mm256_srl_epi32(_mm256_sllv_epi32(_mm256_shuffle_epi8(words, big_endian_mask), shifts),
+                                          value_shift);
+            else
+                values = _mm256_and_si256(_mm256_srlv_epi32(words, shifts), value_mask);
+
+            T* values_output = output + nb_done;
+            if constexpr (sizeof(T) == 4)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(values_output), values);
+            else if constexpr (sizeof(T) == 8)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(values_output),
+                                    _mm256_cvtepu32_epi64(_mm256_castsi256_si128(values)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(values_output + 4),
+                                    _mm256_cvtepu32_epi64(_mm256_extracti128_si256(values, 1)));
+            }
+            else
+            {
+                alignas(32) uint32_t lanes[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), values);
+                for (std::size_t i = 0; i < 8; ++i)
+                    values_output[i] = static_cast<T>(lanes[i]);
+            }
+        }
+    }
+    unpack_bits_scalar_<Order, T>(data, size, bit_position, nb_bits, output + nb_done, count - nb_done);
+}
+#endif
+
+template <bit_order Order, std::unsigned_integral T>
+inline constexpr auto unpack_bits_ = simd_dispatcher(&unpack_bits_scalar_<Order, T>)
+#if defined(ARBA_CORE_SIMD_X86)
+                                         .with(simd_level::avx2, &unpack_bits_avx2_<Order, T>)
+#endif
+    ;
+} // namespace private_
+
+/**
+ * @brief The bit_reader class reads fields of any width from 0 to 64 bits in a byte span.
+ *
+ * Bytes are loaded 8 at a time into a 64-bit buffer, so that reading a field of up to 56 bits costs one refill
+ * test and a few shifts.
+ *
+ * Like load_be() and load_le(), reads are unchecked by default and must not go past the end of the span; the
+ * cppx::maythrow overloads throw std::out_of_range if too few bits remain, or std::invalid_argument if the field is
+ * too large. To check a whole message at once, call require() with its size, then read its fields unchecked.
+ */
+template <bit_order Order = bit_order::msb_first>
+class bit_reader
+{
+public:
+    static constexpr bit_order order = Order;
+
+    explicit bit_reader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    [[nodiscard]] inline std::size_t bit_position() const { return byte_position_ * 8 - nb_buffered_bits_; }
+    [[nodiscard]] inline std::size_t remaining_bits() const { return bytes_.size() * 8 - bit_position(); }
+    [[nodiscard]] inline bool empty() const { return remaining_bits() == 0; }
+
+    // Throws std::out_of_range if fewer than nb_bits bits remain.
+    inline void require(std::size_t nb_bits) const
+    {
+        if (remaining_bits() < nb_bits) [[unlikely]]
+            throw std::out_of_range("Bit reader has not enough bits left.");
+    }
+
+    inline void seek(std::size_t bit_position) { seek_(bit_position); }
+
+    inline void seek(std::size_t bit_position, cppx::maythrow_t)
+    {
+        if (bit_position > bytes_.size() * 8) [[unlikely]]
+            throw std::out_of_range("Bit reader position is out of the bytes range.");
+        seek_(bit_position);
+    }
+
+    inline void skip(std::size_t nb_bits) { seek_(bit_position() + nb_bits); }
+
+    inline void skip(std::size_t nb_bits, cppx::maythrow_t)
+    {
+        require(nb_bits);
+        seek_(bit_position() + nb_bits);
+    }
+
+    // Skips the bits up to the next byte boundary.
+    inline void align_to_byte() { consume_(nb_buffered_bits_ % 8); }
+
+    [[nodiscard]] inline uint64_t read(unsigned nb_bits)
+    {
+        if (nb_bits <= private_::max_buffered_field_size_) [[likely]]
+        {
+            if (nb_buffered_bits_ < nb_bits)
+                refill_();
+            return consume_(nb_bits);
+        }
+        const unsigned nb_first_bits = nb_bits - 32;
+        if constexpr (Order == bit_order::msb_first)
+        {
+            const uint64_t high_bits = read(nb_first_bits);
+            return high_bits << 32 | read(32);
+        }
+        else
+        {
+            const uint64_t low_bits = read(32);
+            return low_bits | read(nb_first_bits) << 32;
+        }
+    }
+
+    [[nodiscard]] inline uint64_t read(unsigned nb_bits, cppx::maythrow_t)
+    {
+        check_field_size_(nb_bits, 64);
+        require(nb_bits);
+        return read(nb_bits);
+    }
+
+    // Returns the next nb_bits bits (at most 56) without consuming them.
+    [[nodiscard]] inline uint64_t peek(unsigned nb_bits)
+    {
+        if (nb_buffered_bits_ < nb_bits)
+            refill_();
+        if constexpr (Order == bit_order::msb_first)
+            return (buffer_ >> 1) >> (63 - nb_bits);
+        else
+            return buffer_ & private_::low_bits_mask_(nb_bits);
+    }
+
+    [[nodiscard]] inline uint64_t peek(unsigned nb_bits, cppx::maythrow_t)
+    {
+        check_field_size_(nb_bits, private_::max_buffered_field_size_);
+        require(nb_bits);
+        return peek(nb_bits);
+    }
+
+    [[nodiscard]] inline bool read_bit() { return read(1) != 0; }
+    [[nodiscard]] inline bool read_bit(cppx::maythrow_t) { return read(1, cppx::maythrow) != 0; }
+
+    // Reads values.size() consecutive fields of nb_bits bits. Fields of up to 25 bits are unpacked with SIMD
+    // instructions when available.
+    template <std::unsigned_integral T, std::size_t Extent>
+    inline void read(std::span<T, Extent> values, unsigned nb_bits)
+    {
+        const std::size_t position = bit_position();
+        private_::unpack_bits_<Order, T>(bytes_.data(), bytes_.size(), position, nb_bits, values.data(),
+                                         values.size());
+        seek_(position + values.size() * nb_bits);
+    }
+
+    template <std::unsigned_integral T, std::size_t Extent>
+    inline void read(std::span<T, Extent> values, unsigned nb_bits, cppx::maythrow_t)
+    {
+        check_field_size_(nb_bits, std::numeric_limits<T>::digits);
+        require(values.size() * nb_bits);
+        read(values, nb_bits);
+    }
+
+private:
+    static inline void check_field_size_(unsigned nb_bits, unsigned max_nb_bits)
+    {
+        if (nb_bits > max_nb_bits) [[unlikely]]
+            throw std::invalid_argument("Bit field size is too large.");
+    }
+
+    // Fills the buffer with at least 56 bits, or up to the end of the bytes. Loaded bits beyond
+    // nb_buffered_bits_ are the next bits of the stream, so loading them again is harmless.
+    inline void refill_()
+    {
+        constexpr std::endian word_endianness = private_::bit_stream_word_endianness_<Order>;
+        if (bytes_.size() >= sizeof(uint64_t) && byte_position_ <= bytes_.size() - sizeof(uint64_t)) [[likely]]
+        {
+            const uint64_t word = private_::load_<word_endianness, uint64_t>(bytes_.data() + byte_position_);
+            if constexpr (Order == bit_order::msb_first)
+                buffer_ |= word >> nb_buffered_bits_;
+            else
+                buffer_ |= word << nb_buffered_bits_;
+            byte_position_ += (63 - nb_buffered_bits_) / 8;
+            nb_buffered_bits_ |= 56;
+            return;
+        }
+        for (; nb_buffered_bits_ <= 56 && byte_position_ < bytes_.size(); ++byte_position_, nb_buffered_bits_ += 8)
+        {
+            const uint64_t byte = static_cast<uint8_t>(bytes_[byte_position_]);
+            if constexpr (Order == bit_order::msb_first)
+                buffer_ |= byte << (56 - nb_buffered_bits_);
+            else
+                buffer_ |= byte << nb_buffered_bits_;
+        }
+    }
+
+    inline uint64_t consume_(unsigned nb_bits)
+    {
+        uint64_t value;
+        if constexpr (Order == bit_order::msb_first)
+        {
+            value = (buffer_ >> 1) >> (63 - nb_bits);
+            buffer_ <<= nb_bits;
+        }
+        else
+        {
+            value = buffer_ & private_::low_bits_mask_(nb_bits);
+            buffer_ >>= nb_bits;
+        }
+        nb_buffered_bits_ -= nb_bits;
+        return value;
+    }
+
+    inline void seek_(std::size_t bit_position)
+    {
+        buffer_ = 0;
+        nb_buffered_bits_ = 0;
+        byte_position_ = bit_position / 8;
+        if (bit_position % 8 != 0)
+        {
+            refill_();
+            consume_(bit_position % 8);
+        }
+    }
+
+    std::span<const std::byte> bytes_;
+    std::size_t byte_position_ = 0;
+    uint64_t buffer_ = 0;
+    unsigned nb_buffered_bits_ = 0;
+};
+
+/**
+ * @brief The bit_writer class writes fields of any width from 0 to 64 bits in a byte span.
+ *
+ * Fields are accumulated in a 64-bit buffer which is stored 8 bytes at a time, so the bytes following the written
+ * ones may be overwritten. The last partial byte is always stored, padded with zeros: there is nothing to flush.
+ *
+ * Like store_be() and store_le(), writes are unchecked by default and must not go past the end of the span; the
+ * cppx::maythrow overloads throw std::length_error if too few bits remain, or std::invalid_argument if the field is
+ * too large.
+ */
+template <bit_order Order = bit_order::msb_first>
+class bit_writer
+{
+public:
+    static constexpr bit_order order = Order;
+
+    explicit bit_writer(std::span<std::byte> bytes) : bytes_(bytes) {}
+
+    [[nodiscard]] inline std::size_t bit_position() const { return byte_position_ * 8 + nb_buffered_bits_; }
+    [[nodiscard]] inline std::size_t remaining_bits() const { return bytes_.size() * 8 - bit_position(); }
+
+    // Returns the written bytes, the last one being padded with zeros.
+    [[nodiscard]] inline std::span<const std::byte> written_bytes() const
+    {
+        return bytes_.first(byte_position_ + (nb_buffered_bits_ != 0));
+    }
+
+    // Pads the current byte with zeros.
+    inline void align_to_byte()
+    {
+        if (nb_buffered_bits_ != 0)
+        {
+            ++byte_position_;
+            buffer_ = 0;
+            nb_buffered_bits_ = 0;
+        }
+    }
+
+    // Writes the nb_bits low bits of value.
+    inline void write(uint64_t value, unsigned nb_bits)
+    {
+        if (nb_bits > private_::max_buffered_field_size_) [[unlikely]]
+        {
+            const unsigned nb_first_bits = nb_bits - 32;
+            if constexpr (Order == bit_order::msb_first)
+            {
+                write(value >> 32, nb_first_bits);
+                write(value, 32);
+            }
+            else
+            {
+                write(value, 32);
+                write(value >> 32, nb_first_bits);
+            }
+            return;
+        }
+        value &= private_::low_bits_mask_(nb_bits);
+        if constexpr (Order == bit_order::msb_first)
+            buffer_ |= (value << (63 - nb_buffered_bits_ - nb_bits)) << 1;
+        else
+            buffer_ |= value << nb_buffered_bits_;
+        nb_buffered_bits_ += nb_bits;
+        flush_();
+    }
+
+    inline void write(uint64_t value, unsigned nb_bits, cppx::maythrow_t)
+    {
+        check_field_size_(nb_bits);
+        require_(nb_bits);
+        write(value, nb_bits);
+    }
+
+    inline void write_bit(bool bit) { write(bit, 1); }
+    inline void write_bit(bool bit, cppx::maythrow_t) { write(bit, 1, cppx::maythrow); }
+
+    // Writes the values as consecutive fields of nb_bits bits.
+    template <typename T, std::size_t Extent>
+        requires std::unsigned_integral<std::remove_const_t<T>>
+    inline void write(std::span<T, Extent> values, unsigned nb_bits)
+    {
+        for (const std::remove_const_t<T> value : values)
+            write(value, nb_bits);
+    }
+
+    template <typename T, std::size_t Extent>
+        requires std::unsigned_integral<std::remove_const_t<T>>
+    inline void write(std::span<T, Extent> values, unsigned nb_bits, cppx::maythrow_t)
+    {
+        check_field_size_(nb_bits);
+        require_(values.size() * nb_bits);
+        write(values, nb_bits);
+    }
+
+private:
+    static inline void check_field_size_(unsigned nb_bits)
+    {
+        if (nb_bits > 64) [[unlikely]]
+            throw std::invalid_argument("Bit field size is too large.");
+    }
+
+    inline void require_(std::size_t nb_bits) const
+    {
+        if (remaining_bits() < nb_bits) [[unlikely]]
+            throw std::length_error("Bit writer buffer is too small.");
+    }
+
+    // Stores the buffered bits, the partial byte included, and keeps only the partial byte in the buffer.
+    inline void flush_()
+    {
+        constexpr std::endian word_endianness = private_::bit_stream_word_endianness_<Order>;
+        if (bytes_.size() >= sizeof(uint64_t) && byte_position_ <= bytes_.size() - sizeof(uint64_t)) [[likely]]
+            private_::store_<word_endianness, uint64_t>(bytes_.data() + byte_position_, buffer_);
+        else
+        {
+            for (std::size_t i = 0; 8 * i < nb_buffered_bits_ && byte_position_ + i < bytes_.size(); ++i)
+            {
+                const unsigned shift = Order == bit_order::msb_first ? 56 - 8 * i : 8 * i;
+                bytes_[byte_position_ + i] = static_cast<std::byte>(buffer_ >> shift);
+            }
+        }
+        const unsigned nb_full_bytes = nb_buffered_bits_ / 8;
+        byte_position_ += nb_full_bytes;
+        if constexpr (Order == bit_order::msb_first)
+            buffer_ <<= 8 * nb_full_bytes;
+        else
+            buffer_ >>= 8 * nb_full_bytes;
+        nb_buffered_bits_ %= 8;
+    }
+
+    std::span<std::byte> bytes_;
+    std::size_t byte_position_ = 0;
+    uint64_t buffer_ = 0;
+    unsigned nb_buffered_bits_ = 0;
+};
+
+} // namespace core
+} // namespace arba
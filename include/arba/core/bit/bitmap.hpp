@@ -0,0 +1,387 @@
+#pragma once
+
+#include <arba/core/simd/simd_dispatcher.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Bitmaps are spans of uint64_t words: bit i is the bit (i % 64) of the word (i / 64), counting from the least
+// significant bit.
+
+inline namespace arba
+{
+namespace core
+{
+
+// Returned by the bitmap search functions when no bit is found.
+inline constexpr std::size_t bit_npos = std::numeric_limits<std::size_t>::max();
+
+namespace private_
+{
+// Popcount:
+
+inline std::size_t popcount_words_scalar_(const uint64_t* words, std::size_t count)
+{
+    std::size_t nb_set_bits = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        nb_set_bits += static_cast<std::size_t>(std::popcount(words[i]));
+    return nb_set_bits;
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+ARBA_CORE_TARGET("sse4.2,popcnt")
+inline std::size_t popcount_words_sse4_2_(const uint64_t* words, std::size_t count)
+{
+    std::size_t nb_set_bits[4] = {};
+    std::size_t i = 0;
+    for (; count - i >= 4; i += 4)
+        for (std::size_t j = 0; j < 4; ++j)
+            nb_set_bits[j] += static_cast<std::size_t>(std::popcount(words[i + j]));
+    for (; i < count; ++i)
+        nb_set_bits[0] += static_cast<std::size_t>(std::popcount(words[i]));
+    return nb_set_bits[0] + nb_set_bits[1] + nb_set_bits[2] + nb_set_bits[3];
+}
+
+// Counts the bits of each nibble with a 16-entry lookup table, then sums the bytes with psadbw.
+ARBA_CORE_TARGET("avx2")
+inline std::size_t popcount_words_avx2_(const uint64_t* words, std::size_t count)
+{
+    const __m256i nibble_counts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2,
+                                                   2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibble_mask = _mm256_set1_epi8(0x0f);
+    __m256i totals = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; count - i >= 4; i += 4)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        const __m256i low_nibbles = _mm256_and_si256(block, low_nibble_mask);
+        const __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibble_mask);
+        const __m256i byte_counts = _mm256_add_epi8(_mm256_shuffle_epi8(nibble_counts, low_nibbles),
+                                                    _mm256_shuffle_epi8(nibble_counts, high_nibbles));
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(byte_counts, _mm256_setzero_si256()));
+    }
+    alignas(32) uint64_t lane_totals[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lane_totals), totals);
+    return static_cast<std::size_t>(lane_totals[0] + lane_totals[1] + lane_totals[2] + lane_totals[3])
+           + popcount_words_scalar_(words + i, count - i);
+}
+
+ARBA_CORE_TARGET("avx512f,avx512vpopcntdq")
+inline std::size_t popcount_words_avx512_vpopcntdq_(const uint64_t* words, std::size_t count)
+{
+    __m512i totals = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; count - i >= 8; i += 8)
+        totals = _mm512_add_epi64(totals, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+    const __mmask8 tail_mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+    totals = _mm512_add_epi64(totals, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(tail_mask, words + i)));
+    alignas(64) uint64_t lane_totals[8];
+    _mm512_store_si512(lane_totals, totals);
+    uint64_t total = 0;
+    for (const uint64_t lane_total : lane_totals)
+        total += lane_total;
+    return static_cast<std::size_t>(total);
+}
+
+// VPOPCNTDQ is not part of the avx512 level: CPUs without it use the AVX2 kernel.
+ARBA_CORE_TARGET("avx512f,avx512bw,avx512dq,avx512vl")
+inline std::size_t popcount_words_avx512_(const uint64_t* words, std::size_t count)
+{
+    if (detected_cpu_features().avx512vpopcntdq)
+        return popcount_words_avx512_vpopcntdq_(words, count);
+    return popcount_words_avx2_(words, count);
+}
+#endif
+
+inline constexpr auto popcount_words_ = simd_dispatcher(&popcount_words_scalar_)
+#if defined(ARBA_CORE_SIMD_X86)
+                                            .with(simd_level::sse4_2, &popcount_words_sse4_2_)
+                                            .with(simd_level::avx2, &popcount_words_avx2_)
+                                            .with(simd_level::avx512, &popcount_words_avx512_)
+#endif
+    ;
+
+// Search of the first non-zero word:
+
+inline std::size_t find_nonzero_word_scalar_(const uint64_t* words, std::size_t count)
+{
+    std::size_t i = 0;
+    while (i < count && words[i] == 0)
+        ++i;
+    return i;
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+ARBA_CORE_TARGET("avx2")
+inline std::size_t find_nonzero_word_avx2_(const uint64_t* words, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; count - i >= 8; i += 8)
+    {
+        const __m256i block = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i)),
+                                              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i + 4)));
+        if (!_mm256_testz_si256(block, block))
+            break;
+    }
+    return i + find_nonzero_word_scalar_(words + i, count - i);
+}
+
+ARBA_CORE_TARGET("avx512f,avx512bw,avx512dq,avx512vl")
+inline std::size_t find_nonzero_word_avx512_(const uint64_t* words, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; count - i >= 8; i += 8)
+    {
+        const __m512i block = _mm512_loadu_si512(words + i);
+        const __mmask8 nonzero_mask = _mm512_test_epi64_mask(block, block);
+        if (nonzero_mask != 0)
+            return i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(nonzero_mask)));
+    }
+    return i + find_nonzero_word_scalar_(words + i, count - i);
+}
+#endif
+
+inline constexpr auto find_nonzero_word_ = simd_dispatcher(&find_nonzero_word_scalar_)
+#if defined(ARBA_CORE_SIMD_X86)
+                                               .with(simd_level::avx2, &find_nonzero_word_avx2_)
+                                               .with(simd_level::avx512, &find_nonzero_word_avx512_)
+#endif
+    ;
+
+// Bitwise operations:
+
+enum class bitwise_operation_ : uint8_t
+{
+    and_,
+    or_,
+    andnot_
+};
+
+template <bitwise_operation_ Operation>
+inline constexpr uint64_t apply_bitwise_operation_(uint64_t lhs, uint64_t rhs)
+{
+    if constexpr (Operation == bitwise_operation_::and_)
+        return lhs & rhs;
+    else if constexpr (Operation == bitwise_operation_::or_)
+        return lhs | rhs;
+    else
+        return lhs & ~rhs;
+}
+
+template <bitwise_operation_ Operation>
+inline void bitwise_words_scalar_(const uint64_t* lhs, const uint64_t* rhs, uint64_t* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = apply_bitwise_operation_<Operation>(lhs[i], rhs[i]);
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+template <bitwise_operation_ Operation>
+ARBA_CORE_TARGET("avx2")
+inline void bitwise_words_avx2_(const uint64_t* lhs, const uint64_t* rhs, uint64_t* output, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; count - i >= 4; i += 4)
+    {
+        const __m256i lhs_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+        const __m256i rhs_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+        __m256i block;
+        if constexpr (Operation == bitwise_operation_::and_)
+            block = _mm256_and_si256(lhs_block, rhs_block);
+        else if constexpr (Operation == bitwise_operation_::or_)
+            block = _mm256_or_si256(lhs_block, rhs_block);
+        else
+            block = _mm256_andnot_si256(rhs_block, lhs_block);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), block);
+    }
+    bitwise_words_scalar_<Operation>(lhs + i, rhs + i, output + i, count - i);
+}
+
+template <bitwise_operation_ Operation>
+ARBA_CORE_TARGET("avx512f,avx512bw,avx512dq,avx512vl")
+inline void bitwise_words_avx512_(const uint64_t* lhs, const uint64_t* rhs, uint64_t* output, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; count - i >= 8; i += 8)
+    {
+        const __m512i lhs_block = _mm512_loadu_si512(lhs + i);
+        const __m512i rhs_block = _mm512_loadu_si512(rhs + i);
+        __m512i block;
+        if constexpr (Operation == bitwise_operation_::and_)
+            block = _mm512_and_si512(lhs_block, rhs_block);
+        else if constexpr (Operation == bitwise_operation_::or_)
+            block = _mm512_or_si512(lhs_block, rhs_block);
+        else // _mm512_andnot_si512 triggers -Wuninitialized with GCC 12.
+            block = _mm512_and_si512(lhs_block, _mm512_xor_si512(rhs_block, _mm512_set1_epi64(-1)));
+        _mm512_storeu_si512(output + i, block);
+    }
+    bitwise_words_scalar_<Operation>(lhs + i, rhs + i, output + i, count - i);
+}
+#endif
+
+template <bitwise_operation_ Operation>
+inline constexpr auto bitwise_words_ = simd_dispatcher(&bitwise_words_scalar_<Operation>)
+#if defined(ARBA_CORE_SIMD_X86)
+                                           .with(simd_level::avx2, &bitwise_words_avx2_<Operation>)
+                                           .with(simd_level::avx512, &bitwise_words_avx512_<Operation>)
+#endif
+    ;
+
+template <bitwise_operation_ Operation>
+inline void bitwise_(std::span<const uint64_t> lhs, std::span<const uint64_t> rhs, std::span<uint64_t> output)
+{
+    if (rhs.size() != lhs.size() || output.size() < lhs.size()) [[unlikely]]
+        throw std::length_error("Bitmap sizes do not match.");
+    bitwise_words_<Operation>(lhs.data(), rhs.data(), output.data(), lhs.size());
+}
+
+// Returns the position of the set bit of rank rank (the first one being of rank 0) in word.
+[[nodiscard]] inline unsigned select_in_word_(uint64_t word, unsigned rank)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    return static_cast<unsigned>(std::countr_zero(_pdep_u64(uint64_t(1) << rank, word)));
+#else
+    for (; rank > 0; --rank)
+        word &= word - 1;
+    return static_cast<unsigned>(std::countr_zero(word));
+#endif
+}
+} // namespace private_
+
+// Scans:
+
+[[nodiscard]] inline std::size_t popcount(std::span<const uint64_t> words)
+{
+    return private_::popcount_words_(words.data(), words.size());
+}
+
+// Returns the position of the first set bit, or bit_npos.
+[[nodiscard]] inline std::size_t find_first_set(std::span<const uint64_t> words)
+{
+    const std::size_t word_index = private_::find_nonzero_word_(words.data(), words.size());
+    if (word_index == words.size())
+        return bit_npos;
+    return word_index * 64 + static_cast<std::size_t>(std::countr_zero(words[word_index]));
+}
+
+// Returns the position of the first set bit at or after bit_position, or bit_npos.
+[[nodiscard]] inline std::size_t find_next_set(std::span<const uint64_t> words, std::size_t bit_position)
+{
+    const std::size_t word_index = bit_position / 64;
+    if (word_index >= words.size())
+        return bit_npos;
+    const uint64_t first_word = words[word_index] & (~uint64_t(0) << (bit_position % 64));
+    if (first_word != 0)
+        return word_index * 64 + static_cast<std::size_t>(std::countr_zero(first_word));
+    const std::size_t next_set = find_first_set(words.subspan(word_index + 1));
+    return next_set == bit_npos ? bit_npos : (word_index + 1) * 64 + next_set;
+}
+
+// Bitwise operations:
+// rhs must be as large as lhs, and output at least as large. output may be lhs or rhs.
+
+inline void bitwise_and(std::span<const uint64_t> lhs, std::span<const uint64_t> rhs, std::span<uint64_t> output)
+{
+    private_::bitwise_<private_::bitwise_operation_::and_>(lhs, rhs, output);
+}
+
+inline void bitwise_or(std::span<const uint64_t> lhs, std::span<const uint64_t> rhs, std::span<uint64_t> output)
+{
+    private_::bitwise_<private_::bitwise_operation_::or_>(lhs, rhs, output);
+}
+
+// output = lhs & ~rhs
+inline void bitwise_andnot(std::span<const uint64_t> lhs, std::span<const uint64_t> rhs, std::span<uint64_t> output)
+{
+    private_::bitwise_<private_::bitwise_operation_::andnot_>(lhs, rhs, output);
+}
+
+/**
+ * @brief The bitmap_rank_select class answers rank (number of set bits before a position) and select (position
+ * of the n-th set bit) queries over a bitmap in constant and logarithmic time.
+ *
+ * It references the bitmap, which must outlive it and not change, and keeps a 64-bit count per 4096-bit
+ * superblock and a 16-bit count per 512-bit block: about 5% of the bitmap size.
+ */
+class bitmap_rank_select
+{
+public:
+    static constexpr std::size_t block_nb_words = 8;
+    static constexpr std::size_t superblock_nb_blocks = 8;
+
+    explicit bitmap_rank_select(std::span<const uint64_t> words) : words_(words)
+    {
+        const std::size_t nb_blocks = (words.size() + block_nb_words - 1) / block_nb_words;
+        superblock_ranks_.reserve((nb_blocks + superblock_nb_blocks - 1) / superblock_nb_blocks);
+        block_ranks_.reserve(nb_blocks);
+        for (std::size_t block = 0; block < nb_blocks; ++block)
+        {
+            if (block % superblock_nb_blocks == 0)
+                superblock_ranks_.push_back(count_);
+            block_ranks_.push_back(static_cast<uint16_t>(count_ - superblock_ranks_.back()));
+            const std::size_t first_word = block * block_nb_words;
+            count_ += private_::popcount_words_scalar_(words.data() + first_word,
+                                                       std::min(block_nb_words, words.size() - first_word));
+        }
+    }
+
+    [[nodiscard]] inline std::span<const uint64_t> words() const { return words_; }
+    [[nodiscard]] inline std::size_t size() const { return words_.size() * 64; }
+    [[nodiscard]] inline std::size_t count() const { return count_; }
+
+    // Returns the number of set bits before bit_position. Throws std::out_of_range if bit_position > size().
+    [[nodiscard]] inline std::size_t rank(std::size_t bit_position) const
+    {
+        if (bit_position >= size()) [[unlikely]]
+        {
+            if (bit_position > size())
+                throw std::out_of_range("Bit position is out of the bitmap range.");
+            return count_;
+        }
+        const std::size_t word_index = bit_position / 64;
+        const std::size_t block = word_index / block_nb_words;
+        std::size_t nb_set_bits = superblock_ranks_[block / superblock_nb_blocks] + block_ranks_[block];
+        nb_set_bits += private_::popcount_words_scalar_(words_.data() + block * block_nb_words,
+                                                        word_index - block * block_nb_words);
+        const uint64_t low_bits_mask = (uint64_t(1) << (bit_position % 64)) - 1;
+        return nb_set_bits + static_cast<std::size_t>(std::popcount(words_[word_index] & low_bits_mask));
+    }
+
+    // Returns the position of the set bit of rank rank (the first one being of rank 0), or bit_npos if
+    // rank >= count().
+    [[nodiscard]] inline std::size_t select(std::size_t rank) const
+    {
+        if (rank >= count_) [[unlikely]]
+            return bit_npos;
+        const auto superblock_iter = std::ranges::upper_bound(superblock_ranks_, rank) - 1;
+        const std::size_t superblock = static_cast<std::size_t>(superblock_iter - superblock_ranks_.begin());
+        rank -= superblock_ranks_[superblock];
+        std::size_t block = superblock * superblock_nb_blocks;
+        const std::size_t last_block = std::min(block + superblock_nb_blocks, block_ranks_.size());
+        while (block + 1 < last_block && block_ranks_[block + 1] <= rank)
+            ++block;
+        rank -= block_ranks_[block];
+        for (std::size_t word_index = block * block_nb_words;; ++word_index)
+        {
+            const std::size_t word_count = static_cast<std::size_t>(std::popcount(words_[word_index]));
+            if (rank < word_count)
+                return word_index * 64 + private_::select_in_word_(words_[word_index], static_cast<unsigned>(rank));
+            rank -= word_count;
+        }
+    }
+
+private:
+    std::span<const uint64_t> words_;
+    std::vector<uint64_t> superblock_ranks_;
+    std::vector<uint16_t> block_ranks_;
+    std::size_t count_ = 0;
+};
+
+} // namespace core
+} // namespace arba
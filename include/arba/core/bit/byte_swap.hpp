@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -12,24 +15,37 @@ inline namespace arba
 {
 namespace core
 {
-inline uint16_t byte_swap(uint16_t value)
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128_t;
+__extension__ typedef __int128 int128_t;
+#endif
+
+inline constexpr uint16_t byte_swap(uint16_t value)
 {
-#if (defined(__GNUC__) && !defined(__ICC))
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#elif (defined(__GNUC__) && !defined(__ICC))
     return __builtin_bswap16(value);
-#elif defined(_MSC_VER) && !defined(_DEBUG)
-    return _byteswap_ushort(value);
 #else
+#if defined(_MSC_VER) && !defined(_DEBUG)
+    if (!std::is_constant_evaluated())
+        return _byteswap_ushort(value);
+#endif
     return uint16_t(value << 8) | uint16_t(value >> 8);
 #endif
 }
 
-inline uint32_t byte_swap(uint32_t value)
+inline constexpr uint32_t byte_swap(uint32_t value)
 {
-#if (defined(__GNUC__) && !defined(__ICC))
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#elif (defined(__GNUC__) && !defined(__ICC))
     return __builtin_bswap32(value);
-#elif defined(_MSC_VER) && !defined(_DEBUG)
-    return _byteswap_ulong(value);
 #else
+#if defined(_MSC_VER) && !defined(_DEBUG)
+    if (!std::is_constant_evaluated())
+        return _byteswap_ulong(value);
+#endif
     // clang-format off
     return uint32_t((value & 0x000000ff) << 24)
          | uint32_t((value & 0x0000ff00) << 8)
@@ -39,13 +55,17 @@ inline uint32_t byte_swap(uint32_t value)
 #endif
 }
 
-inline uint64_t byte_swap(uint64_t value)
+inline constexpr uint64_t byte_swap(uint64_t value)
 {
-#if (defined(__GNUC__) && !defined(__ICC))
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#elif (defined(__GNUC__) && !defined(__ICC))
     return __builtin_bswap64(value);
-#elif defined(_MSC_VER) && !defined(_DEBUG)
-    return _byteswap_uint64(value);
 #else
+#if defined(_MSC_VER) && !defined(_DEBUG)
+    if (!std::is_constant_evaluated())
+        return _byteswap_uint64(value);
+#endif
     // clang-format off
     return uint64_t((value & 0x00000000000000ff) << 56)
          | uint64_t((value & 0x000000000000ff00) << 40)
@@ -59,60 +79,147 @@ inline uint64_t byte_swap(uint64_t value)
 #endif
 }
 
-inline char16_t byte_swap(char16_t value)
+#if defined(__SIZEOF_INT128__)
+inline constexpr uint128_t byte_swap(uint128_t value)
+{
+#if __has_builtin(__builtin_bswap128)
+    return __builtin_bswap128(value);
+#else
+    return (uint128_t(byte_swap(uint64_t(value))) << 64) | uint128_t(byte_swap(uint64_t(value >> 64)));
+#endif
+}
+
+inline constexpr int128_t byte_swap(int128_t value)
+{
+    return static_cast<int128_t>(byte_swap(static_cast<uint128_t>(value)));
+}
+#endif
+
+inline constexpr char16_t byte_swap(char16_t value)
 {
     static_assert(sizeof(char16_t) == sizeof(uint16_t));
-    uint16_t result = byte_swap(*reinterpret_cast<uint16_t*>(&value));
-    return *reinterpret_cast<char16_t*>(&result);
+    return std::bit_cast<char16_t>(byte_swap(std::bit_cast<uint16_t>(value)));
 }
 
-inline char32_t byte_swap(char32_t value)
+inline constexpr char32_t byte_swap(char32_t value)
 {
     static_assert(sizeof(char32_t) == sizeof(uint32_t));
-    uint32_t result = byte_swap(*reinterpret_cast<uint32_t*>(&value));
-    return *reinterpret_cast<char32_t*>(&result);
+    return std::bit_cast<char32_t>(byte_swap(std::bit_cast<uint32_t>(value)));
 }
 
-inline float byte_swap(float value)
+inline constexpr float byte_swap(float value)
 {
     static_assert(sizeof(float) == sizeof(uint32_t));
     static_assert(std::numeric_limits<float>::is_iec559);
-    union float_uint_convertor
-    {
-        float fval;
-        uint32_t uval;
-    } convertor{ .fval = value };
-    convertor.uval = byte_swap(convertor.uval);
-    return convertor.fval;
+    return std::bit_cast<float>(byte_swap(std::bit_cast<uint32_t>(value)));
 }
 
-inline double byte_swap(double value)
+inline constexpr double byte_swap(double value)
 {
     static_assert(sizeof(double) == sizeof(uint64_t));
     static_assert(std::numeric_limits<double>::is_iec559);
-    union double_uint_convertor
-    {
-        double dval;
-        uint64_t uval;
-    } convertor{ .dval = value };
-    convertor.uval = byte_swap(convertor.uval);
-    return convertor.dval;
+    return std::bit_cast<double>(byte_swap(std::bit_cast<uint64_t>(value)));
 }
 
 template <typename T>
     requires std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) >= 2)
-inline T byte_swap(T value)
+inline constexpr T byte_swap(T value)
 {
     return static_cast<T>(byte_swap(static_cast<std::make_unsigned_t<T>>(value)));
 }
 
 template <typename T>
     requires std::is_enum_v<T> && (sizeof(T) >= 2)
-inline T byte_swap(T value)
+inline constexpr T byte_swap(T value)
 {
     return static_cast<T>(byte_swap(static_cast<std::underlying_type_t<T>>(value)));
 }
 
+// Fixed-size byte arrays (keys, identifiers, ...) are swapped as a whole, like an N-byte integer.
+template <typename ByteType, std::size_t N>
+    requires(sizeof(ByteType) == 1 && std::is_trivially_copyable_v<ByteType> && N >= 2)
+inline constexpr std::array<ByteType, N> byte_swap(const std::array<ByteType, N>& value)
+{
+    std::array<ByteType, N> result{};
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = value[N - 1 - i];
+    return result;
+}
+
+// Aggregates:
+
+/**
+ * @brief byte_swap_fields lists the members of T swapped by byte_swap(T).
+ *
+ * Specialize it for an aggregate, deriving from byte_swap_field_list, to make it byte swappable:
+ * @code
+ * template <>
+ * struct core::byte_swap_fields<record_header> : core::byte_swap_field_list<&record_header::size, &record_header::id>
+ * {
+ * };
+ * @endcode
+ * Members of one byte are left as is. Arrays (C arrays or std::array) of wider values are swapped element-wise.
+ */
+template <typename T>
+struct byte_swap_fields
+{
+};
+
+template <auto... MemberPointers>
+struct byte_swap_field_list
+{
+};
+
+namespace private_
+{
+template <auto... MemberPointers>
+std::true_type is_byte_swap_field_list_(const byte_swap_field_list<MemberPointers...>*);
+std::false_type is_byte_swap_field_list_(const void*);
+
+template <typename T>
+inline constexpr bool is_std_array_ = false;
+
+template <typename T, std::size_t N>
+inline constexpr bool is_std_array_<std::array<T, N>> = true;
+} // namespace private_
+
+template <typename T>
+concept FieldwiseByteSwappable
+    = std::is_class_v<T>
+      && decltype(private_::is_byte_swap_field_list_(static_cast<const byte_swap_fields<T>*>(nullptr)))::value;
+
+template <FieldwiseByteSwappable T>
+inline constexpr T byte_swap(const T& value);
+
+namespace private_
+{
+template <typename FieldType>
+inline constexpr void byte_swap_field_in_place_(FieldType& field)
+{
+    if constexpr (std::is_array_v<FieldType> || is_std_array_<FieldType>)
+    {
+        for (auto& element : field)
+            byte_swap_field_in_place_(element);
+    }
+    else if constexpr (sizeof(FieldType) > 1)
+        field = byte_swap(field);
+}
+
+template <typename T, auto... MemberPointers>
+inline constexpr void byte_swap_fields_in_place_(T& value, const byte_swap_field_list<MemberPointers...>&)
+{
+    (byte_swap_field_in_place_(value.*MemberPointers), ...);
+}
+} // namespace private_
+
+template <FieldwiseByteSwappable T>
+inline constexpr T byte_swap(const T& value)
+{
+    T result = value;
+    private_::byte_swap_fields_in_place_(result, byte_swap_fields<T>{});
+    return result;
+}
+
 template <typename T>
 concept ByteSwappable = requires(T value) {
     { byte_swap(value) } -> std::same_as<T>;
@@ -0,0 +1,358 @@
+#pragma once
+
+#include "byte_swap.hpp"
+
+#include <arba/core/simd/simd_dispatcher.hpp>
+#include <arba/meta/type_traits/integer_n.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+inline namespace arba
+{
+namespace core
+{
+
+namespace private_
+{
+template <typename T>
+inline constexpr bool is_int128_ = false;
+#if defined(__SIZEOF_INT128__)
+template <>
+inline constexpr bool is_int128_<uint128_t> = true;
+template <>
+inline constexpr bool is_int128_<int128_t> = true;
+#endif
+} // namespace private_
+
+template <typename T>
+concept BulkByteSwappable
+    = ByteSwappable<T>
+      && (((std::is_arithmetic_v<T> || std::is_enum_v<T> || private_::is_int128_<T>)
+           && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 || sizeof(T) == 16))
+          || (FieldwiseByteSwappable<T> && std::is_trivially_copyable_v<T>));
+
+namespace private_
+{
+template <std::size_t ElementSize>
+struct byte_swap_uint_traits_
+{
+    using type = meta::uint_n_t<ElementSize * 8>;
+};
+
+#if defined(__SIZEOF_INT128__)
+template <>
+struct byte_swap_uint_traits_<16>
+{
+    using type = uint128_t;
+};
+#endif
+
+template <std::size_t ElementSize>
+using byte_swap_uint_ = typename byte_swap_uint_traits_<ElementSize>::type;
+
+template <std::size_t ElementSize>
+inline void byte_swap_copy_scalar_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, input += ElementSize, output += ElementSize)
+    {
+        byte_swap_uint_<ElementSize> value;
+        std::memcpy(&value, input, ElementSize);
+        value = byte_swap(value);
+        std::memcpy(output, &value, ElementSize);
+    }
+}
+
+// Shuffle mask reversing the bytes of each ElementSize-byte element, repeated over 4 lanes of 16 bytes.
+template <std::size_t ElementSize>
+inline constexpr std::array<char, 64> byte_swap_mask_ = []
+{
+    std::array<char, 64> mask{};
+    for (std::size_t i = 0; i < mask.size(); ++i)
+        mask[i] = static_cast<char>((i % 16 / ElementSize) * ElementSize + (ElementSize - 1 - i % ElementSize));
+    return mask;
+}();
+
+#if defined(ARBA_CORE_SIMD_X86)
+template <std::size_t ElementSize>
+ARBA_CORE_TARGET("ssse3")
+inline std::size_t byte_swap_copy_ssse3_blocks_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    constexpr std::size_t nb_elements_per_block = 16 / ElementSize;
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byte_swap_mask_<ElementSize>.data()));
+    const std::size_t nb_blocks = count / nb_elements_per_block;
+    for (std::size_t i = 0; i < nb_blocks; ++i, input += 16, output += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_shuffle_epi8(block, mask));
+    }
+    return nb_blocks * nb_elements_per_block;
+}
+
+template <std::size_t ElementSize>
+ARBA_CORE_TARGET("avx2")
+inline std::size_t byte_swap_copy_avx2_blocks_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    constexpr std::size_t nb_elements_per_block = 32 / ElementSize;
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(byte_swap_mask_<ElementSize>.data()));
+    const std::size_t nb_blocks = count / nb_elements_per_block;
+    for (std::size_t i = 0; i < nb_blocks; ++i, input += 32, output += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_shuffle_epi8(block, mask));
+    }
+    return nb_blocks * nb_elements_per_block;
+}
+
+template <std::size_t ElementSize>
+ARBA_CORE_TARGET("avx512f,avx512bw")
+inline std::size_t byte_swap_copy_avx512_blocks_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    constexpr std::size_t nb_elements_per_block = 64 / ElementSize;
+    const __m512i mask = _mm512_loadu_si512(byte_swap_mask_<ElementSize>.data());
+    const std::size_t nb_blocks = count / nb_elements_per_block;
+    for (std::size_t i = 0; i < nb_blocks; ++i, input += 64, output += 64)
+    {
+        const __m512i block = _mm512_loadu_si512(input);
+        _mm512_storeu_si512(output, _mm512_shuffle_epi8(block, mask));
+    }
+    return nb_blocks * nb_elements_per_block;
+}
+
+template <std::size_t ElementSize>
+ARBA_CORE_TARGET("ssse3")
+inline void byte_swap_copy_ssse3_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    const std::size_t nb_done = byte_swap_copy_ssse3_blocks_<ElementSize>(input, output, count);
+    byte_swap_copy_scalar_<ElementSize>(input + nb_done * ElementSize, output + nb_done * ElementSize,
+                                        count - nb_done);
+}
+
+template <std::size_t ElementSize>
+ARBA_CORE_TARGET("avx2")
+inline void byte_swap_copy_avx2_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    const std::size_t nb_done = byte_swap_copy_avx2_blocks_<ElementSize>(input, output, count);
+    byte_swap_copy_ssse3_<ElementSize>(input + nb_done * ElementSize, output + nb_done * ElementSize,
+                                       count - nb_done);
+}
+
+template <std::size_t ElementSize>
+ARBA_CORE_TARGET("avx512f,avx512bw")
+inline void byte_swap_copy_avx512_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    const std::size_t nb_done = byte_swap_copy_avx512_blocks_<ElementSize>(input, output, count);
+    byte_swap_copy_avx2_<ElementSize>(input + nb_done * ElementSize, output + nb_done * ElementSize,
+                                      count - nb_done);
+}
+#endif
+
+// Byte swaps count elements of ElementSize bytes from input to output (which may be equal).
+// Neither input nor output needs to be aligned.
+template <std::size_t ElementSize>
+inline constexpr auto byte_swap_copy_bytes_ = simd_dispatcher(&byte_swap_copy_scalar_<ElementSize>)
+#if defined(ARBA_CORE_SIMD_X86)
+                                                  .with(simd_level::ssse3, &byte_swap_copy_ssse3_<ElementSize>)
+                                                  .with(simd_level::avx2, &byte_swap_copy_avx2_<ElementSize>)
+                                                  .with(simd_level::avx512, &byte_swap_copy_avx512_<ElementSize>)
+#endif
+    ;
+
+// Aggregates:
+// byte_swap of an aggregate being a fixed permutation of its bytes, the permutation is computed once (by swapping
+// an object holding the bytes 0, 1, 2...) and turned into shuffle masks. Values of up to 16 bytes are packed in
+// 16-byte blocks (several per block if they divide 16), bigger values are handled 16 bytes at a time, provided
+// no field straddles two 16-byte windows. Values not meeting these conditions are swapped field by field.
+
+template <typename T>
+struct byte_swap_fields_shuffle_
+{
+    static constexpr std::size_t nb_values_per_block = sizeof(T) <= 16 ? 16 / sizeof(T) : 1;
+    static constexpr std::size_t block_size = sizeof(T) <= 16 ? nb_values_per_block * sizeof(T) : sizeof(T);
+    static constexpr std::size_t nb_windows = (block_size + 15) / 16;
+
+    // Shuffle masks of the 16-byte windows of a block. If the block is 16 bytes long, the mask is repeated over
+    // 4 lanes. Bytes beyond the block are left as is, so that a window overflowing on the next value is harmless.
+    std::array<std::array<char, 16>, nb_windows < 4 ? 4 : nb_windows> masks{};
+    bool is_vectorizable = false;
+};
+
+template <typename T>
+inline byte_swap_fields_shuffle_<T> make_byte_swap_fields_shuffle_()
+{
+    using shuffle_type = byte_swap_fields_shuffle_<T>;
+    shuffle_type shuffle;
+    if constexpr (sizeof(T) <= 256)
+    {
+        std::array<unsigned char, sizeof(T)> permutation;
+        for (std::size_t i = 0; i < permutation.size(); ++i)
+            permutation[i] = static_cast<unsigned char>(i);
+        // bit_cast only needs T to be trivially copyable, not default constructible.
+        T value = std::bit_cast<T>(permutation);
+        byte_swap_fields_in_place_(value, byte_swap_fields<T>{});
+        permutation = std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+
+        shuffle.is_vectorizable = true;
+        for (std::size_t window = 0; window < shuffle_type::nb_windows; ++window)
+        {
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                const std::size_t block_index = window * 16 + i;
+                std::size_t source_index = block_index;
+                if (block_index < shuffle_type::block_size)
+                {
+                    const std::size_t value_offset = block_index / sizeof(T) * sizeof(T);
+                    source_index = value_offset + permutation[block_index - value_offset];
+                    shuffle.is_vectorizable = shuffle.is_vectorizable && source_index / 16 == window;
+                }
+                shuffle.masks[window][i] = static_cast<char>(source_index - window * 16);
+            }
+        }
+        if constexpr (shuffle_type::block_size == 16)
+            std::fill(shuffle.masks.begin() + 1, shuffle.masks.end(), shuffle.masks[0]);
+    }
+    return shuffle;
+}
+
+template <typename T>
+inline const byte_swap_fields_shuffle_<T>& byte_swap_fields_shuffle_of_()
+{
+    static const byte_swap_fields_shuffle_<T> shuffle = make_byte_swap_fields_shuffle_<T>();
+    return shuffle;
+}
+
+template <typename T>
+inline void byte_swap_fields_copy_scalar_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, input += sizeof(T), output += sizeof(T))
+    {
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), input, sizeof(T));
+        T value = std::bit_cast<T>(bytes);
+        byte_swap_fields_in_place_(value, byte_swap_fields<T>{});
+        std::memcpy(output, &value, sizeof(T));
+    }
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+template <typename T>
+ARBA_CORE_TARGET("ssse3")
+inline void byte_swap_fields_copy_ssse3_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    using shuffle_type = byte_swap_fields_shuffle_<T>;
+    const shuffle_type& shuffle = byte_swap_fields_shuffle_of_<T>();
+    std::size_t nb_done = 0;
+    if (shuffle.is_vectorizable)
+    {
+        __m128i masks[shuffle_type::nb_windows];
+        for (std::size_t window = 0; window < shuffle_type::nb_windows; ++window)
+            masks[window] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.masks[window].data()));
+        // The windows of the last block may read and write up to 15 bytes beyond it.
+        for (; (count - nb_done) * sizeof(T) >= shuffle_type::nb_windows * 16;
+             nb_done += shuffle_type::nb_values_per_block)
+        {
+            const std::byte* block_input = input + nb_done * sizeof(T);
+            std::byte* block_output = output + nb_done * sizeof(T);
+            for (std::size_t window = 0; window < shuffle_type::nb_windows; ++window)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block_input + window * 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(block_output + window * 16),
+                                 _mm_shuffle_epi8(block, masks[window]));
+            }
+        }
+    }
+    byte_swap_fields_copy_scalar_<T>(input + nb_done * sizeof(T), output + nb_done * sizeof(T), count - nb_done);
+}
+
+template <typename T>
+ARBA_CORE_TARGET("avx2")
+inline void byte_swap_fields_copy_avx2_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    std::size_t nb_done = 0;
+    if constexpr (byte_swap_fields_shuffle_<T>::block_size == 16)
+    {
+        const byte_swap_fields_shuffle_<T>& shuffle = byte_swap_fields_shuffle_of_<T>();
+        if (shuffle.is_vectorizable)
+        {
+            constexpr std::size_t nb_values_per_block = 32 / sizeof(T);
+            const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shuffle.masks.data()));
+            for (; count - nb_done >= nb_values_per_block; nb_done += nb_values_per_block)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + nb_done * sizeof(T)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + nb_done * sizeof(T)),
+                                    _mm256_shuffle_epi8(block, mask));
+            }
+        }
+    }
+    byte_swap_fields_copy_ssse3_<T>(input + nb_done * sizeof(T), output + nb_done * sizeof(T), count - nb_done);
+}
+
+template <typename T>
+ARBA_CORE_TARGET("avx512f,avx512bw")
+inline void byte_swap_fields_copy_avx512_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    std::size_t nb_done = 0;
+    if constexpr (byte_swap_fields_shuffle_<T>::block_size == 16)
+    {
+        const byte_swap_fields_shuffle_<T>& shuffle = byte_swap_fields_shuffle_of_<T>();
+        if (shuffle.is_vectorizable)
+        {
+            constexpr std::size_t nb_values_per_block = 64 / sizeof(T);
+            const __m512i mask = _mm512_loadu_si512(shuffle.masks.data());
+            for (; count - nb_done >= nb_values_per_block; nb_done += nb_values_per_block)
+            {
+                const __m512i block = _mm512_loadu_si512(input + nb_done * sizeof(T));
+                _mm512_storeu_si512(output + nb_done * sizeof(T), _mm512_shuffle_epi8(block, mask));
+            }
+        }
+    }
+    byte_swap_fields_copy_avx2_<T>(input + nb_done * sizeof(T), output + nb_done * sizeof(T), count - nb_done);
+}
+#endif
+
+template <typename T>
+inline constexpr auto byte_swap_fields_copy_ = simd_dispatcher(&byte_swap_fields_copy_scalar_<T>)
+#if defined(ARBA_CORE_SIMD_X86)
+                                                   .with(simd_level::ssse3, &byte_swap_fields_copy_ssse3_<T>)
+                                                   .with(simd_level::avx2, &byte_swap_fields_copy_avx2_<T>)
+                                                   .with(simd_level::avx512, &byte_swap_fields_copy_avx512_<T>)
+#endif
+    ;
+
+// Byte swaps count values of type T from input to output (which may be equal).
+// Neither input nor output needs to be aligned.
+template <BulkByteSwappable T>
+inline void byte_swap_copy_values_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    if constexpr (FieldwiseByteSwappable<T>)
+        byte_swap_fields_copy_<T>(input, output, count);
+    else
+        byte_swap_copy_bytes_<sizeof(T)>(input, output, count);
+}
+} // namespace private_
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void byte_swap(std::span<T> values)
+{
+    std::byte* bytes = reinterpret_cast<std::byte*>(values.data());
+    private_::byte_swap_copy_values_<T>(bytes, bytes, values.size());
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void byte_swap_copy(std::span<const std::type_identity_t<T>> input, std::span<T> output)
+{
+    if (output.size() < input.size()) [[unlikely]]
+        throw std::length_error("Output span is smaller than input span.");
+    private_::byte_swap_copy_values_<T>(reinterpret_cast<const std::byte*>(input.data()),
+                                        reinterpret_cast<std::byte*>(output.data()), input.size());
+}
+
+} // namespace core
+} // namespace arba
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "byte_swap_span.hpp"
+#include "load_store.hpp"
+
+#include <array>
+#include <compare>
+#include <span>
+#include <stdexcept>
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief The endian_value class stores a value in a given byte order, and converts it on access.
+ *
+ * It has the size of T, an alignment of 1 and is trivially copyable, so that a packed struct of endian_values
+ * can be overlaid directly on a file mapping or a network buffer.
+ */
+template <EndianLoadable T, std::endian Endianness>
+class endian_value
+{
+public:
+    using value_type = T;
+    static constexpr std::endian endianness = Endianness;
+
+    endian_value() = default;
+    explicit endian_value(T value) { set_value(value); }
+
+    [[nodiscard]] inline T value() const { return private_::load_<Endianness, T>(bytes_.data()); }
+    inline void set_value(T value) { private_::store_<Endianness, T>(bytes_.data(), value); }
+    [[nodiscard]] inline operator T() const { return value(); }
+
+    [[nodiscard]] inline std::span<const std::byte, sizeof(T)> bytes() const { return bytes_; }
+    [[nodiscard]] inline std::span<std::byte, sizeof(T)> bytes() { return bytes_; }
+
+    inline endian_value& operator=(T value)
+    {
+        set_value(value);
+        return *this;
+    }
+
+    inline endian_value& operator+=(T rhs)
+        requires std::is_arithmetic_v<T>
+    {
+        return *this = static_cast<T>(value() + rhs);
+    }
+
+    inline endian_value& operator-=(T rhs)
+        requires std::is_arithmetic_v<T>
+    {
+        return *this = static_cast<T>(value() - rhs);
+    }
+
+    inline endian_value& operator*=(T rhs)
+        requires std::is_arithmetic_v<T>
+    {
+        return *this = static_cast<T>(value() * rhs);
+    }
+
+    inline endian_value& operator/=(T rhs)
+        requires std::is_arithmetic_v<T>
+    {
+        return *this = static_cast<T>(value() / rhs);
+    }
+
+    inline endian_value& operator%=(T rhs)
+        requires std::is_integral_v<T>
+    {
+        return *this = static_cast<T>(value() % rhs);
+    }
+
+    inline endian_value& operator&=(T rhs)
+        requires std::is_integral_v<T>
+    {
+        return *this = static_cast<T>(value() & rhs);
+    }
+
+    inline endian_value& operator|=(T rhs)
+        requires std::is_integral_v<T>
+    {
+        return *this = static_cast<T>(value() | rhs);
+    }
+
+    inline endian_value& operator^=(T rhs)
+        requires std::is_integral_v<T>
+    {
+        return *this = static_cast<T>(value() ^ rhs);
+    }
+
+    inline endian_value& operator<<=(int rhs)
+        requires std::is_integral_v<T>
+    {
+        return *this = static_cast<T>(value() << rhs);
+    }
+
+    inline endian_value& operator>>=(int rhs)
+        requires std::is_integral_v<T>
+    {
+        return *this = static_cast<T>(value() >> rhs);
+    }
+
+    inline endian_value& operator++()
+        requires std::is_arithmetic_v<T>
+    {
+        return *this += T(1);
+    }
+
+    inline endian_value& operator--()
+        requires std::is_arithmetic_v<T>
+    {
+        return *this -= T(1);
+    }
+
+    inline T operator++(int)
+        requires std::is_arithmetic_v<T>
+    {
+        const T old_value = value();
+        *this = static_cast<T>(old_value + T(1));
+        return old_value;
+    }
+
+    inline T operator--(int)
+        requires std::is_arithmetic_v<T>
+    {
+        const T old_value = value();
+        *this = static_cast<T>(old_value - T(1));
+        return old_value;
+    }
+
+    [[nodiscard]] inline bool operator==(const endian_value& rhs) const { return value() == rhs.value(); }
+    [[nodiscard]] inline auto operator<=>(const endian_value& rhs) const { return value() <=> rhs.value(); }
+
+private:
+    std::array<std::byte, sizeof(T)> bytes_;
+};
+
+template <EndianLoadable T>
+using big_endian = endian_value<T, std::endian::big>;
+
+template <EndianLoadable T>
+using little_endian = endian_value<T, std::endian::little>;
+
+namespace private_
+{
+template <typename T>
+inline constexpr bool is_endian_value_ = false;
+
+template <typename T, std::endian Endianness>
+inline constexpr bool is_endian_value_<endian_value<T, Endianness>> = true;
+
+template <typename T, std::endian Endianness>
+inline void endian_copy_values_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    if constexpr (sizeof(T) == 1 || Endianness == std::endian::native)
+    {
+        if (count > 0)
+            std::memcpy(output, input, count * sizeof(T));
+    }
+    else if constexpr (BulkByteSwappable<T>)
+        byte_swap_copy_values_<T>(input, output, count);
+    else
+    {
+        // No bulk kernel for the other swappable types, like byte arrays: values are swapped one by one.
+        for (std::size_t i = 0; i < count; ++i)
+            store_<std::endian::native, T>(output + i * sizeof(T), load_<Endianness, T>(input + i * sizeof(T)));
+    }
+}
+
+inline void check_endian_values_output_size_(std::size_t input_size, std::size_t output_size)
+{
+    if (output_size < input_size) [[unlikely]]
+        throw std::length_error("Output span is smaller than input span.");
+}
+} // namespace private_
+
+// Bulk conversions:
+
+template <typename EndianValue, std::size_t Extent>
+    requires private_::is_endian_value_<std::remove_const_t<EndianValue>>
+inline void to_host(std::span<EndianValue, Extent> input,
+                    std::span<typename std::remove_const_t<EndianValue>::value_type> output)
+{
+    using value_type = typename std::remove_const_t<EndianValue>::value_type;
+    private_::check_endian_values_output_size_(input.size(), output.size());
+    private_::endian_copy_values_<value_type, EndianValue::endianness>(
+        reinterpret_cast<const std::byte*>(input.data()), reinterpret_cast<std::byte*>(output.data()), input.size());
+}
+
+template <typename T, std::endian Endianness>
+inline void from_host(std::span<const std::type_identity_t<T>> input, std::span<endian_value<T, Endianness>> output)
+{
+    private_::check_endian_values_output_size_(input.size(), output.size());
+    private_::endian_copy_values_<T, Endianness>(reinterpret_cast<const std::byte*>(input.data()),
+                                                 reinterpret_cast<std::byte*>(output.data()), input.size());
+}
+
+} // namespace core
+} // namespace arba
@@ -1,17 +1,49 @@
 #pragma once
 
 #include "byte_swap.hpp"
+#include "byte_swap_span.hpp"
 
 #include <bit>
+#include <cstring>
+#include <span>
+#include <stdexcept>
 
 inline namespace arba
 {
 namespace core
 {
+namespace private_
+{
+// Copies count values of type T from input to output, converting them from host to world (big endian)
+// byte order, or vice versa, which is the same operation. input and output may be equal.
+template <typename T>
+inline void htow_copy_values_(const std::byte* input, std::byte* output, std::size_t count)
+{
+    if constexpr (std::endian::native == std::endian::little)
+        byte_swap_copy_values_<std::remove_const_t<T>>(input, output, count);
+    else if (input != output && count > 0)
+        std::memcpy(output, input, count * sizeof(T));
+}
+
+inline void check_htow_output_size_(std::size_t input_size, std::size_t output_size)
+{
+    if (output_size < input_size) [[unlikely]]
+        throw std::length_error("Output span is smaller than input span.");
+}
+
+template <typename T>
+inline std::size_t htow_input_count_(std::span<const std::byte> input)
+{
+    if (input.size() % sizeof(T) != 0) [[unlikely]]
+        throw std::invalid_argument("Input bytes size is not a multiple of the value type size.");
+    return input.size() / sizeof(T);
+}
+} // namespace private_
+
 // Host TO World:
 
 template <ByteSwappable T>
-inline T htow(T value)
+inline constexpr T htow(T value)
 {
     if constexpr (std::endian::native == std::endian::little)
         return byte_swap(value);
@@ -19,10 +51,36 @@ inline T htow(T value)
         return value;
 }
 
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow(std::span<T> values)
+{
+    std::byte* bytes = reinterpret_cast<std::byte*>(values.data());
+    private_::htow_copy_values_<T>(bytes, bytes, values.size());
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow(std::span<const std::type_identity_t<T>> input, std::span<T> output)
+{
+    private_::check_htow_output_size_(input.size(), output.size());
+    private_::htow_copy_values_<T>(reinterpret_cast<const std::byte*>(input.data()),
+                                   reinterpret_cast<std::byte*>(output.data()), input.size());
+}
+
+// Converts input values to world byte order while copying them to the raw output buffer (which needs no alignment).
+template <typename T, std::size_t Extent>
+    requires BulkByteSwappable<std::remove_const_t<T>>
+inline void htow(std::span<T, Extent> input, std::span<std::byte> output)
+{
+    private_::check_htow_output_size_(input.size_bytes(), output.size());
+    private_::htow_copy_values_<T>(reinterpret_cast<const std::byte*>(input.data()), output.data(), input.size());
+}
+
 // World TO Host:
 
 template <ByteSwappable T>
-inline T wtoh(T value)
+inline constexpr T wtoh(T value)
 {
     if constexpr (std::endian::native == std::endian::little)
         return byte_swap(value);
@@ -30,5 +88,33 @@ inline T wtoh(T value)
         return value;
 }
 
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh(std::span<T> values)
+{
+    std::byte* bytes = reinterpret_cast<std::byte*>(values.data());
+    private_::htow_copy_values_<T>(bytes, bytes, values.size());
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh(std::span<const std::type_identity_t<T>> input, std::span<T> output)
+{
+    private_::check_htow_output_size_(input.size(), output.size());
+    private_::htow_copy_values_<T>(reinterpret_cast<const std::byte*>(input.data()),
+                                   reinterpret_cast<std::byte*>(output.data()), input.size());
+}
+
+// Converts the values of the raw input buffer (which needs no alignment) to host byte order while copying them
+// to output.
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh(std::span<const std::byte> input, std::span<T> output)
+{
+    const std::size_t count = private_::htow_input_count_<T>(input);
+    private_::check_htow_output_size_(count, output.size());
+    private_::htow_copy_values_<T>(input.data(), reinterpret_cast<std::byte*>(output.data()), count);
+}
+
 } // namespace core
 } // namespace arba
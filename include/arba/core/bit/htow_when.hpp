@@ -8,33 +8,210 @@ inline namespace arba
 {
 namespace core
 {
+namespace private_
+{
+// Copies count values of type T from input to output, swapping their bytes if required.
+// input and output may be equal.
+template <typename T>
+inline void byte_swap_copy_values_if_(const std::byte* input, std::byte* output, std::size_t count, bool swap)
+{
+    if (swap)
+        byte_swap_copy_values_<std::remove_const_t<T>>(input, output, count);
+    else if (input != output && count > 0)
+        std::memcpy(output, input, count * sizeof(T));
+}
+} // namespace private_
+
 // Host TO World:
 
 template <ByteSwappable T>
-inline T htow_when(T value, cppx::endianness_neutral_t)
+inline constexpr T htow_when(T value, cppx::endianness_neutral_t)
 {
     return htow(value);
 }
 
 template <ByteSwappable T>
-inline T htow_when(T value, cppx::endianness_specific_t)
+inline constexpr T htow_when(T value, cppx::endianness_specific_t)
 {
     return value;
 }
 
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow_when(std::span<T> values, cppx::endianness_neutral_t)
+{
+    htow(values);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow_when(std::span<T>, cppx::endianness_specific_t)
+{
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow_when(std::span<const std::type_identity_t<T>> input, std::span<T> output,
+                      cppx::endianness_neutral_t)
+{
+    htow(input, output);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow_when(std::span<const std::type_identity_t<T>> input, std::span<T> output,
+                      cppx::endianness_specific_t)
+{
+    private_::check_htow_output_size_(input.size(), output.size());
+    private_::byte_swap_copy_values_if_<T>(reinterpret_cast<const std::byte*>(input.data()),
+                                           reinterpret_cast<std::byte*>(output.data()), input.size(), false);
+}
+
+template <typename T, std::size_t Extent>
+    requires BulkByteSwappable<std::remove_const_t<T>>
+inline void htow_when(std::span<T, Extent> input, std::span<std::byte> output, cppx::endianness_neutral_t)
+{
+    htow(input, output);
+}
+
+template <typename T, std::size_t Extent>
+    requires BulkByteSwappable<std::remove_const_t<T>>
+inline void htow_when(std::span<T, Extent> input, std::span<std::byte> output, cppx::endianness_specific_t)
+{
+    private_::check_htow_output_size_(input.size_bytes(), output.size());
+    private_::byte_swap_copy_values_if_<T>(reinterpret_cast<const std::byte*>(input.data()), output.data(),
+                                           input.size(), false);
+}
+
 // World TO Host:
 
 template <ByteSwappable T>
-inline T wtoh_when(T value, cppx::endianness_neutral_t)
+inline constexpr T wtoh_when(T value, cppx::endianness_neutral_t)
 {
     return wtoh(value);
 }
 
 template <ByteSwappable T>
-inline T wtoh_when(T value, cppx::endianness_specific_t)
+inline constexpr T wtoh_when(T value, cppx::endianness_specific_t)
 {
     return value;
 }
 
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<T> values, cppx::endianness_neutral_t)
+{
+    wtoh(values);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<T>, cppx::endianness_specific_t)
+{
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<const std::type_identity_t<T>> input, std::span<T> output,
+                      cppx::endianness_neutral_t)
+{
+    wtoh(input, output);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<const std::type_identity_t<T>> input, std::span<T> output,
+                      cppx::endianness_specific_t)
+{
+    private_::check_htow_output_size_(input.size(), output.size());
+    private_::byte_swap_copy_values_if_<T>(reinterpret_cast<const std::byte*>(input.data()),
+                                           reinterpret_cast<std::byte*>(output.data()), input.size(), false);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<const std::byte> input, std::span<T> output, cppx::endianness_neutral_t)
+{
+    wtoh(input, output);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<const std::byte> input, std::span<T> output, cppx::endianness_specific_t)
+{
+    const std::size_t count = private_::htow_input_count_<T>(input);
+    private_::check_htow_output_size_(count, output.size());
+    private_::byte_swap_copy_values_if_<T>(input.data(), reinterpret_cast<std::byte*>(output.data()), count, false);
+}
+
+// Runtime selected endianness:
+// The world byte order is only known at run time (e.g. read from a file header). Values are byte swapped
+// if it differs from the host one. The decision is taken once per buffer, not once per value.
+
+template <ByteSwappable T>
+inline constexpr T htow_when(T value, std::endian world_endianness)
+{
+    return world_endianness != std::endian::native ? byte_swap(value) : value;
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow_when(std::span<T> values, std::endian world_endianness)
+{
+    std::byte* bytes = reinterpret_cast<std::byte*>(values.data());
+    private_::byte_swap_copy_values_if_<T>(bytes, bytes, values.size(), world_endianness != std::endian::native);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void htow_when(std::span<const std::type_identity_t<T>> input, std::span<T> output,
+                      std::endian world_endianness)
+{
+    private_::check_htow_output_size_(input.size(), output.size());
+    private_::byte_swap_copy_values_if_<T>(reinterpret_cast<const std::byte*>(input.data()),
+                                           reinterpret_cast<std::byte*>(output.data()), input.size(),
+                                           world_endianness != std::endian::native);
+}
+
+template <typename T, std::size_t Extent>
+    requires BulkByteSwappable<std::remove_const_t<T>>
+inline void htow_when(std::span<T, Extent> input, std::span<std::byte> output, std::endian world_endianness)
+{
+    private_::check_htow_output_size_(input.size_bytes(), output.size());
+    private_::byte_swap_copy_values_if_<T>(reinterpret_cast<const std::byte*>(input.data()), output.data(),
+                                           input.size(), world_endianness != std::endian::native);
+}
+
+template <ByteSwappable T>
+inline constexpr T wtoh_when(T value, std::endian world_endianness)
+{
+    return world_endianness != std::endian::native ? byte_swap(value) : value;
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<T> values, std::endian world_endianness)
+{
+    htow_when(values, world_endianness);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<const std::type_identity_t<T>> input, std::span<T> output,
+                      std::endian world_endianness)
+{
+    htow_when(input, output, world_endianness);
+}
+
+template <BulkByteSwappable T>
+    requires(!std::is_const_v<T>)
+inline void wtoh_when(std::span<const std::byte> input, std::span<T> output, std::endian world_endianness)
+{
+    const std::size_t count = private_::htow_input_count_<T>(input);
+    private_::check_htow_output_size_(count, output.size());
+    private_::byte_swap_copy_values_if_<T>(input.data(), reinterpret_cast<std::byte*>(output.data()), count,
+                                           world_endianness != std::endian::native);
+}
+
 } // namespace core
 } // namespace arba
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "byte_swap.hpp"
+
+#include <arba/cppx/policy/exception_policy.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+inline namespace arba
+{
+namespace core
+{
+
+template <typename T>
+concept EndianLoadable = std::is_trivially_copyable_v<T> && (sizeof(T) == 1 || ByteSwappable<T>);
+
+namespace private_
+{
+template <std::endian Endianness, EndianLoadable T>
+[[nodiscard]] inline T load_(const std::byte* bytes)
+{
+    std::array<std::byte, sizeof(T)> value_bytes;
+    std::memcpy(value_bytes.data(), bytes, sizeof(T));
+    // bit_cast only needs T to be trivially copyable, not default constructible.
+    const T value = std::bit_cast<T>(value_bytes);
+    if constexpr (sizeof(T) > 1 && Endianness != std::endian::native)
+        return byte_swap(value);
+    else
+        return value;
+}
+
+template <std::endian Endianness, EndianLoadable T>
+inline void store_(std::byte* bytes, T value)
+{
+    if constexpr (sizeof(T) > 1 && Endianness != std::endian::native)
+    {
+        const T swapped_value = byte_swap(value);
+        std::memcpy(bytes, &swapped_value, sizeof(T));
+    }
+    else
+        std::memcpy(bytes, &value, sizeof(T));
+}
+
+[[noreturn]] inline void throw_load_store_out_of_range_()
+{
+    throw std::out_of_range("Value is out of the bytes range.");
+}
+
+inline void check_load_store_range_(std::size_t bytes_size, std::size_t offset, std::size_t value_size)
+{
+    if (offset > bytes_size || bytes_size - offset < value_size) [[unlikely]]
+        throw_load_store_out_of_range_();
+}
+} // namespace private_
+
+// Loads a value stored in big (_be) or little (_le) endian at bytes[offset], whatever its alignment.
+
+template <EndianLoadable T>
+[[nodiscard]] inline T load_be(std::span<const std::byte> bytes, std::size_t offset = 0)
+{
+    return private_::load_<std::endian::big, T>(bytes.data() + offset);
+}
+
+template <EndianLoadable T>
+[[nodiscard]] inline T load_be(std::span<const std::byte> bytes, std::size_t offset, cppx::maythrow_t)
+{
+    private_::check_load_store_range_(bytes.size(), offset, sizeof(T));
+    return private_::load_<std::endian::big, T>(bytes.data() + offset);
+}
+
+template <EndianLoadable T>
+[[nodiscard]] inline T load_le(std::span<const std::byte> bytes, std::size_t offset = 0)
+{
+    return private_::load_<std::endian::little, T>(bytes.data() + offset);
+}
+
+template <EndianLoadable T>
+[[nodiscard]] inline T load_le(std::span<const std::byte> bytes, std::size_t offset, cppx::maythrow_t)
+{
+    private_::check_load_store_range_(bytes.size(), offset, sizeof(T));
+    return private_::load_<std::endian::little, T>(bytes.data() + offset);
+}
+
+// Stores a value in big (_be) or little (_le) endian at bytes[offset], whatever its alignment.
+
+template <EndianLoadable T>
+inline void store_be(std::span<std::byte> bytes, std::size_t offset, T value)
+{
+    private_::store_<std::endian::big, T>(bytes.data() + offset, value);
+}
+
+template <EndianLoadable T>
+inline void store_be(std::span<std::byte> bytes, std::size_t offset, T value, cppx::maythrow_t)
+{
+    private_::check_load_store_range_(bytes.size(), offset, sizeof(T));
+    private_::store_<std::endian::big, T>(bytes.data() + offset, value);
+}
+
+template <EndianLoadable T>
+inline void store_le(std::span<std::byte> bytes, std::size_t offset, T value)
+{
+    private_::store_<std::endian::little, T>(bytes.data() + offset, value);
+}
+
+template <EndianLoadable T>
+inline void store_le(std::span<std::byte> bytes, std::size_t offset, T value, cppx::maythrow_t)
+{
+    private_::check_load_store_range_(bytes.size(), offset, sizeof(T));
+    private_::store_<std::endian::little, T>(bytes.data() + offset, value);
+}
+
+} // namespace core
+} // namespace arba
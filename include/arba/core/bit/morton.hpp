@@ -0,0 +1,393 @@
+#pragma once
+
+#include <arba/core/simd/simd_dispatcher.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+inline namespace arba
+{
+namespace core
+{
+
+// Bit deposit and extract:
+
+/**
+ * @brief Deposits the low bits of value at the positions of the set bits of mask, from the lowest one.
+ *
+ * Uses the BMI2 pdep instruction when it is enabled at compile time.
+ */
+template <std::unsigned_integral T>
+[[nodiscard]] inline constexpr T pdep(T value, T mask)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    if (!std::is_constant_evaluated())
+    {
+        if constexpr (sizeof(T) == sizeof(uint64_t))
+            return static_cast<T>(_pdep_u64(value, mask));
+        else if constexpr (sizeof(T) <= sizeof(uint32_t))
+            return static_cast<T>(_pdep_u32(value, mask));
+    }
+#endif
+    T result = 0;
+    for (T bit = 1; mask != 0; bit = static_cast<T>(bit << 1))
+    {
+        const T lowest_mask_bit = static_cast<T>(mask & (T(0) - mask));
+        if (value & bit)
+            result |= lowest_mask_bit;
+        mask ^= lowest_mask_bit;
+    }
+    return result;
+}
+
+/**
+ * @brief Extracts the bits of value at the positions of the set bits of mask, and packs them in the low bits.
+ *
+ * Uses the BMI2 pext instruction when it is enabled at compile time.
+ */
+template <std::unsigned_integral T>
+[[nodiscard]] inline constexpr T pext(T value, T mask)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    if (!std::is_constant_evaluated())
+    {
+        if constexpr (sizeof(T) == sizeof(uint64_t))
+            return static_cast<T>(_pext_u64(value, mask));
+        else if constexpr (sizeof(T) <= sizeof(uint32_t))
+            return static_cast<T>(_pext_u32(value, mask));
+    }
+#endif
+    T result = 0;
+    for (T bit = 1; mask != 0; bit = static_cast<T>(bit << 1))
+    {
+        const T lowest_mask_bit = static_cast<T>(mask & (T(0) - mask));
+        if (value & lowest_mask_bit)
+            result |= bit;
+        mask ^= lowest_mask_bit;
+    }
+    return result;
+}
+
+// Morton (Z-order) codes:
+// The bit i of x goes to the bit 2i (2D) or 3i (3D) of the code, y and z following it.
+
+namespace private_
+{
+struct magic_bits_step_
+{
+    unsigned shift;
+    uint64_t mask;
+};
+
+// Spreading moves groups of bits left, in halving sizes; compacting applies the steps in reverse order.
+template <std::size_t Dimension>
+inline constexpr std::array<magic_bits_step_, 5> morton_steps_
+    = Dimension == 2 ? std::array<magic_bits_step_, 5>{ { { 16, 0x0000ffff0000ffff },
+                                                          { 8, 0x00ff00ff00ff00ff },
+                                                          { 4, 0x0f0f0f0f0f0f0f0f },
+                                                          { 2, 0x3333333333333333 },
+                                                          { 1, 0x5555555555555555 } } }
+                     : std::array<magic_bits_step_, 5>{ { { 32, 0x001f00000000ffff },
+                                                          { 16, 0x001f0000ff0000ff },
+                                                          { 8, 0x100f00f00f00f00f },
+                                                          { 4, 0x10c30c30c30c30c3 },
+                                                          { 2, 0x1249249249249249 } } };
+
+// Bits of a coordinate kept in a code.
+template <std::size_t Dimension>
+inline constexpr uint64_t morton_input_mask_ = Dimension == 2 ? 0xffffffff : 0x1fffff;
+
+// Bits of a code holding the first coordinate.
+template <std::size_t Dimension>
+inline constexpr uint64_t morton_mask_ = morton_steps_<Dimension>.back().mask;
+
+template <std::size_t Dimension>
+[[nodiscard]] inline constexpr uint64_t spread_bits_(uint64_t value)
+{
+    value &= morton_input_mask_<Dimension>;
+    for (const magic_bits_step_& step : morton_steps_<Dimension>)
+        value = (value | value << step.shift) & step.mask;
+    return value;
+}
+
+template <std::size_t Dimension>
+[[nodiscard]] inline constexpr uint64_t compact_bits_(uint64_t value)
+{
+    constexpr const std::array<magic_bits_step_, 5>& steps = morton_steps_<Dimension>;
+    value &= steps.back().mask;
+    for (std::size_t i = steps.size() - 1; i > 0; --i)
+        value = (value | value >> steps[i].shift) & steps[i - 1].mask;
+    return (value | value >> steps.front().shift) & morton_input_mask_<Dimension>;
+}
+} // namespace private_
+
+[[nodiscard]] inline constexpr uint64_t morton_encode_2d(uint32_t x, uint32_t y)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    if (!std::is_constant_evaluated())
+        return _pdep_u64(x, private_::morton_mask_<2>) | _pdep_u64(y, private_::morton_mask_<2> << 1);
+#endif
+    return private_::spread_bits_<2>(x) | private_::spread_bits_<2>(y) << 1;
+}
+
+[[nodiscard]] inline constexpr std::array<uint32_t, 2> morton_decode_2d(uint64_t code)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    if (!std::is_constant_evaluated())
+        return { static_cast<uint32_t>(_pext_u64(code, private_::morton_mask_<2>)),
+                 static_cast<uint32_t>(_pext_u64(code, private_::morton_mask_<2> << 1)) };
+#endif
+    return { static_cast<uint32_t>(private_::compact_bits_<2>(code)),
+             static_cast<uint32_t>(private_::compact_bits_<2>(code >> 1)) };
+}
+
+// Only the 21 low bits of each coordinate are encoded.
+[[nodiscard]] inline constexpr uint64_t morton_encode_3d(uint32_t x, uint32_t y, uint32_t z)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    if (!std::is_constant_evaluated())
+        return _pdep_u64(x, private_::morton_mask_<3>) | _pdep_u64(y, private_::morton_mask_<3> << 1)
+               | _pdep_u64(z, private_::morton_mask_<3> << 2);
+#endif
+    return private_::spread_bits_<3>(x) | private_::spread_bits_<3>(y) << 1 | private_::spread_bits_<3>(z) << 2;
+}
+
+[[nodiscard]] inline constexpr std::array<uint32_t, 3> morton_decode_3d(uint64_t code)
+{
+#if defined(ARBA_CORE_HAS_BMI2_64)
+    if (!std::is_constant_evaluated())
+        return { static_cast<uint32_t>(_pext_u64(code, private_::morton_mask_<3>)),
+                 static_cast<uint32_t>(_pext_u64(code, private_::morton_mask_<3> << 1)),
+                 static_cast<uint32_t>(_pext_u64(code, private_::morton_mask_<3> << 2)) };
+#endif
+    return { static_cast<uint32_t>(private_::compact_bits_<3>(code)),
+             static_cast<uint32_t>(private_::compact_bits_<3>(code >> 1)),
+             static_cast<uint32_t>(private_::compact_bits_<3>(code >> 2)) };
+}
+
+namespace private_
+{
+// Bulk kernels: coordinates are in separate arrays.
+
+template <std::size_t Dimension>
+inline void morton_encode_scalar_(const std::array<const uint32_t*, Dimension>& coordinates, uint64_t* codes,
+                                  std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if constexpr (Dimension == 2)
+            codes[i] = morton_encode_2d(coordinates[0][i], coordinates[1][i]);
+        else
+            codes[i] = morton_encode_3d(coordinates[0][i], coordinates[1][i], coordinates[2][i]);
+    }
+}
+
+template <std::size_t Dimension>
+inline void morton_decode_scalar_(const uint64_t* codes, const std::array<uint32_t*, Dimension>& coordinates,
+                                  std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::array<uint32_t, Dimension> point;
+        if constexpr (Dimension == 2)
+            point = morton_decode_2d(codes[i]);
+        else
+            point = morton_decode_3d(codes[i]);
+        for (std::size_t j = 0; j < Dimension; ++j)
+            coordinates[j][i] = point[j];
+    }
+}
+
+inline void pdep_scalar_(const uint64_t* values, uint64_t mask, uint64_t* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = pdep(values[i], mask);
+}
+
+inline void pext_scalar_(const uint64_t* values, uint64_t mask, uint64_t* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = pext(values[i], mask);
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+// The magic bits steps are applied to 4 coordinates at once.
+template <std::size_t Dimension>
+ARBA_CORE_TARGET("avx2")
+inline __m256i spread_bits_avx2_(__m256i values)
+{
+    values = _mm256_and_si256(values, _mm256_set1_epi64x(static_cast<long long>(morton_input_mask_<Dimension>)));
+    for (const magic_bits_step_& step : morton_steps_<Dimension>)
+    {
+        const __m256i shifted_values = _mm256_sll_epi64(values, _mm_cvtsi32_si128(static_cast<int>(step.shift)));
+        values = _mm256_and_si256(_mm256_or_si256(values, shifted_values),
+                                  _mm256_set1_epi64x(static_cast<long long>(step.mask)));
+    }
+    return values;
+}
+
+template <std::size_t Dimension>
+ARBA_CORE_TARGET("avx2")
+inline __m256i compact_bits_avx2_(__m256i values)
+{
+    constexpr const std::array<magic_bits_step_, 5>& steps = morton_steps_<Dimension>;
+    values = _mm256_and_si256(values, _mm256_set1_epi64x(static_cast<long long>(steps.back().mask)));
+    for (std::size_t i = steps.size() - 1; i > 0; --i)
+    {
+        const __m256i shifted_values = _mm256_srl_epi64(values, _mm_cvtsi32_si128(static_cast<int>(steps[i].shift)));
+        values = _mm256_and_si256(_mm256_or_si256(values, shifted_values),
+                                  _mm256_set1_epi64x(static_cast<long long>(steps[i - 1].mask)));
+    }
+    const __m256i shifted_values = _mm256_srl_epi64(values, _mm_cvtsi32_si128(static_cast<int>(steps.front().shift)));
+    values = _mm256_or_si256(values, shifted_values);
+    return _mm256_and_si256(values, _mm256_set1_epi64x(static_cast<long long>(morton_input_mask_<Dimension>)));
+}
+
+template <std::size_t Dimension>
+ARBA_CORE_TARGET("avx2")
+inline void morton_encode_avx2_(const std::array<const uint32_t*, Dimension>& coordinates, uint64_t* codes,
+                                std::size_t count)
+{
+    std::size_t i = 0;
+    for (; count - i >= 4; i += 4)
+    {
+        __m256i code = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < Dimension; ++j)
+        {
+            const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coordinates[j] + i));
+            const __m256i spread_values = spread_bits_avx2_<Dimension>(_mm256_cvtepu32_epi64(values));
+            code = _mm256_or_si256(code, _mm256_sll_epi64(spread_values, _mm_cvtsi32_si128(static_cast<int>(j))));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + i), code);
+    }
+    std::array<const uint32_t*, Dimension> tail_coordinates;
+    for (std::size_t j = 0; j < Dimension; ++j)
+        tail_coordinates[j] = coordinates[j] + i;
+    morton_encode_scalar_<Dimension>(tail_coordinates, codes + i, count - i);
+}
+
+template <std::size_t Dimension>
+ARBA_CORE_TARGET("avx2")
+inline void morton_decode_avx2_(const uint64_t* codes, const std::array<uint32_t*, Dimension>& coordinates,
+                                std::size_t count)
+{
+    const __m256i even_lanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    std::size_t i = 0;
+    for (; count - i >= 4; i += 4)
+    {
+        const __m256i code = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i));
+        for (std::size_t j = 0; j < Dimension; ++j)
+        {
+            const __m256i values
+                = compact_bits_avx2_<Dimension>(_mm256_srl_epi64(code, _mm_cvtsi32_si128(static_cast<int>(j))));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(coordinates[j] + i),
+                             _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(values, even_lanes)));
+        }
+    }
+    std::array<uint32_t*, Dimension> tail_coordinates;
+    for (std::size_t j = 0; j < Dimension; ++j)
+        tail_coordinates[j] = coordinates[j] + i;
+    morton_decode_scalar_<Dimension>(codes + i, tail_coordinates, count - i);
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+ARBA_CORE_TARGET("bmi2")
+inline void pdep_bmi2_(const uint64_t* values, uint64_t mask, uint64_t* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = _pdep_u64(values[i], mask);
+}
+
+ARBA_CORE_TARGET("bmi2")
+inline void pext_bmi2_(const uint64_t* values, uint64_t mask, uint64_t* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = _pext_u64(values[i], mask);
+}
+#endif
+#endif
+
+template <std::size_t Dimension>
+inline constexpr auto morton_encode_ = simd_dispatcher(&morton_encode_scalar_<Dimension>)
+#if defined(ARBA_CORE_SIMD_X86)
+                                           .with(simd_level::avx2, &morton_encode_avx2_<Dimension>)
+#endif
+    ;
+
+template <std::size_t Dimension>
+inline constexpr auto morton_decode_ = simd_dispatcher(&morton_decode_scalar_<Dimension>)
+#if defined(ARBA_CORE_SIMD_X86)
+                                           .with(simd_level::avx2, &morton_decode_avx2_<Dimension>)
+#endif
+    ;
+
+// The avx2 level implies BMI2.
+inline constexpr auto pdep_ = simd_dispatcher(&pdep_scalar_)
+#if defined(ARBA_CORE_SIMD_X86) && (defined(__x86_64__) || defined(_M_X64))
+                                  .with(simd_level::avx2, &pdep_bmi2_)
+#endif
+    ;
+
+inline constexpr auto pext_ = simd_dispatcher(&pext_scalar_)
+#if defined(ARBA_CORE_SIMD_X86) && (defined(__x86_64__) || defined(_M_X64))
+                                  .with(simd_level::avx2, &pext_bmi2_)
+#endif
+    ;
+
+inline void check_bulk_sizes_(bool sizes_are_valid)
+{
+    if (!sizes_are_valid) [[unlikely]]
+        throw std::length_error("Span sizes do not match.");
+}
+} // namespace private_
+
+// Spans:
+// Output spans must be at least as large as input spans, and input coordinate spans of the same size.
+
+inline void pdep(std::span<const uint64_t> values, uint64_t mask, std::span<uint64_t> output)
+{
+    private_::check_bulk_sizes_(output.size() >= values.size());
+    private_::pdep_(values.data(), mask, output.data(), values.size());
+}
+
+inline void pext(std::span<const uint64_t> values, uint64_t mask, std::span<uint64_t> output)
+{
+    private_::check_bulk_sizes_(output.size() >= values.size());
+    private_::pext_(values.data(), mask, output.data(), values.size());
+}
+
+inline void morton_encode_2d(std::span<const uint32_t> xs, std::span<const uint32_t> ys, std::span<uint64_t> codes)
+{
+    private_::check_bulk_sizes_(ys.size() == xs.size() && codes.size() >= xs.size());
+    private_::morton_encode_<2>(std::array{ xs.data(), ys.data() }, codes.data(), xs.size());
+}
+
+inline void morton_decode_2d(std::span<const uint64_t> codes, std::span<uint32_t> xs, std::span<uint32_t> ys)
+{
+    private_::check_bulk_sizes_(std::min(xs.size(), ys.size()) >= codes.size());
+    private_::morton_decode_<2>(codes.data(), std::array{ xs.data(), ys.data() }, codes.size());
+}
+
+inline void morton_encode_3d(std::span<const uint32_t> xs, std::span<const uint32_t> ys,
+                             std::span<const uint32_t> zs, std::span<uint64_t> codes)
+{
+    private_::check_bulk_sizes_(ys.size() == xs.size() && zs.size() == xs.size() && codes.size() >= xs.size());
+    private_::morton_encode_<3>(std::array{ xs.data(), ys.data(), zs.data() }, codes.data(), xs.size());
+}
+
+inline void morton_decode_3d(std::span<const uint64_t> codes, std::span<uint32_t> xs, std::span<uint32_t> ys,
+                             std::span<uint32_t> zs)
+{
+    private_::check_bulk_sizes_(std::min({ xs.size(), ys.size(), zs.size() }) >= codes.size());
+    private_::morton_decode_<3>(codes.data(), std::array{ xs.data(), ys.data(), zs.data() }, codes.size());
+}
+
+} // namespace core
+} // namespace arba
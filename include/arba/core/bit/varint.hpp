@@ -0,0 +1,417 @@
+#pragma once
+
+#include <arba/core/simd/simd_dispatcher.hpp>
+#include <arba/cppx/policy/exception_policy.hpp>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+inline namespace arba
+{
+namespace core
+{
+
+// Zigzag:
+// Maps signed integers to unsigned ones so that small magnitudes give small values: 0, -1, 1, -2... -> 0, 1, 2, 3...
+
+template <std::signed_integral T>
+[[nodiscard]] inline constexpr std::make_unsigned_t<T> zigzag_encode(T value)
+{
+    using unsigned_type = std::make_unsigned_t<T>;
+    return static_cast<unsigned_type>(static_cast<unsigned_type>(value) << 1)
+           ^ static_cast<unsigned_type>(value >> (std::numeric_limits<T>::digits));
+}
+
+template <std::unsigned_integral T>
+[[nodiscard]] inline constexpr std::make_signed_t<T> zigzag_decode(T value)
+{
+    return static_cast<std::make_signed_t<T>>((value >> 1) ^ (T(0) - (value & 1)));
+}
+
+template <std::signed_integral T>
+inline void zigzag_encode(std::span<const std::type_identity_t<T>> input, std::span<std::make_unsigned_t<T>> output)
+{
+    if (output.size() < input.size()) [[unlikely]]
+        throw std::length_error("Output span is smaller than input span.");
+    for (std::size_t i = 0; i < input.size(); ++i)
+        output[i] = zigzag_encode(input[i]);
+}
+
+template <std::unsigned_integral T>
+inline void zigzag_decode(std::span<const std::type_identity_t<T>> input, std::span<std::make_signed_t<T>> output)
+{
+    if (output.size() < input.size()) [[unlikely]]
+        throw std::length_error("Output span is smaller than input span.");
+    for (std::size_t i = 0; i < input.size(); ++i)
+        output[i] = zigzag_decode(input[i]);
+}
+
+// Varint (unsigned LEB128):
+// 7 bits per byte, least significant group first, the high bit of each byte telling if another one follows.
+
+template <std::unsigned_integral T>
+inline constexpr std::size_t max_varint_size = (std::numeric_limits<T>::digits + 6) / 7;
+
+template <std::unsigned_integral T>
+[[nodiscard]] inline constexpr std::size_t varint_size(T value)
+{
+    return (static_cast<std::size_t>(std::bit_width(static_cast<T>(value | T(1)))) + 6) / 7;
+}
+
+/**
+ * @brief The varint_decode_result struct holds a decoded value and the number of bytes it was read from.
+ *
+ * size is 0 if the input is truncated or does not hold a valid varint of type T (too long or overflowing).
+ */
+template <std::unsigned_integral T>
+struct varint_decode_result
+{
+    T value = 0;
+    std::size_t size = 0;
+};
+
+/**
+ * @brief The varints_decode_result struct tells how many values were decoded and how many bytes were read.
+ *
+ * Decoding stops when the output is full, or at the first truncated or malformed varint.
+ */
+struct varints_decode_result
+{
+    std::size_t nb_values = 0;
+    std::size_t nb_bytes = 0;
+};
+
+namespace private_
+{
+template <std::unsigned_integral T>
+inline constexpr varint_decode_result<T> decode_varint_(const std::byte* input, std::size_t input_size)
+{
+    constexpr std::size_t max_size = max_varint_size<T>;
+    const std::size_t size_limit = input_size < max_size ? input_size : max_size;
+    T value = 0;
+    for (std::size_t i = 0; i < size_limit; ++i)
+    {
+        const T group = static_cast<T>(static_cast<uint8_t>(input[i]) & 0x7f);
+        if (i == max_size - 1 && (group >> (std::numeric_limits<T>::digits - 7 * i)) != 0) [[unlikely]]
+            return {};
+        value |= static_cast<T>(group << (7 * i));
+        if ((static_cast<uint8_t>(input[i]) & 0x80) == 0)
+            return { value, i + 1 };
+    }
+    return {};
+}
+
+template <std::unsigned_integral T>
+inline constexpr std::size_t encode_varint_(T value, std::byte* output)
+{
+    std::size_t size = 0;
+    for (; value >= 0x80; value >>= 7)
+        output[size++] = static_cast<std::byte>(static_cast<uint8_t>(value) | 0x80);
+    output[size++] = static_cast<std::byte>(value);
+    return size;
+}
+
+inline varints_decode_result decode_varints_scalar_(const std::byte* input, std::size_t input_size, uint64_t* output,
+                                                    std::size_t output_size)
+{
+    varints_decode_result result;
+    for (; result.nb_values < output_size; ++result.nb_values)
+    {
+        const varint_decode_result<uint64_t> value
+            = decode_varint_<uint64_t>(input + result.nb_bytes, input_size - result.nb_bytes);
+        if (value.size == 0)
+            break;
+        output[result.nb_values] = value.value;
+        result.nb_bytes += value.size;
+    }
+    return result;
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+// The clear high bits of 16 bytes mark the last bytes of the varints ending in them. The run of one-byte varints
+// (frequent with small lengths and deltas) at their beginning, or 8 two-byte varints, are widened at once; the
+// varints after the run are decoded one per end bit, without reloading the chunk until another run begins.
+
+// Gathers the 7-bit groups of the 8 bytes of word, least significant first: pairs, then quadruples, then halves are
+// joined with constant shifts. pext would do it in one instruction, but it is microcoded on AMD processors before
+// Zen 3, where it takes hundreds of cycles with such a dense mask.
+inline constexpr uint64_t gather_varint_groups_(uint64_t word)
+{
+    word = (word & 0x007f'007f'007f'007f) | ((word & 0x7f00'7f00'7f00'7f00) >> 1);
+    word = (word & 0x0000'3fff'0000'3fff) | ((word & 0x3fff'0000'3fff'0000) >> 2);
+    return (word & 0x0000'0000'0fff'ffff) | ((word & 0x0fff'ffff'0000'0000) >> 4);
+}
+
+// Varints of up to 8 bytes are decoded without loop: their size is given by the first clear high bit of an 8-byte
+// load, and their 7-bit groups are gathered branch-free. Longer or truncated ones are decoded byte by byte.
+inline varint_decode_result<uint64_t> decode_multi_byte_varint_(const std::byte* input, std::size_t input_size)
+{
+    constexpr uint64_t high_bits = 0x8080808080808080;
+    if (input_size >= sizeof(uint64_t)) [[likely]]
+    {
+        uint64_t word;
+        std::memcpy(&word, input, sizeof(word));
+        if (const uint64_t end_bits = ~word & high_bits; end_bits != 0) [[likely]]
+        {
+            const std::size_t size = static_cast<std::size_t>(std::countr_zero(end_bits)) / 8 + 1;
+            return { gather_varint_groups_(word & (~high_bits >> (64 - 8 * size))), size };
+        }
+    }
+    return decode_varint_<uint64_t>(input, input_size);
+}
+
+// Decodes the varints from position to the end of the 16 bytes at input, given end_mask whose bits are set at the
+// last bytes of the varints ending in them. Their sizes are known, so their groups are gathered from an 8-byte load
+// without looking for their end again. The varint crossing the end of the 16 bytes is decoded as well.
+// Stops before a run of 4 one-byte varints, which is faster to widen from a new chunk.
+// Returns the number of values decoded and the position after the last one, which stays at 0 if the chunk starts with
+// a malformed varint.
+inline varints_decode_result decode_chunk_varints_(const std::byte* input, std::size_t input_size, unsigned end_mask,
+                                                   std::size_t position, uint64_t* output)
+{
+    constexpr uint64_t high_bits = 0x8080808080808080;
+    varints_decode_result result{ position, position };
+    for (unsigned end_bits = end_mask & (0xffffu << position); end_bits != 0; end_bits &= end_bits - 1)
+    {
+        const std::size_t end = static_cast<std::size_t>(std::countr_zero(end_bits)) + 1;
+        const std::size_t size = end - result.nb_bytes;
+        if (size <= sizeof(uint64_t) && input_size - result.nb_bytes >= sizeof(uint64_t)) [[likely]]
+        {
+            uint64_t word;
+            std::memcpy(&word, input + result.nb_bytes, sizeof(word));
+            output[result.nb_values] = gather_varint_groups_(word & (~high_bits >> (64 - 8 * size)));
+        }
+        else
+        {
+            const varint_decode_result<uint64_t> value
+                = decode_varint_<uint64_t>(input + result.nb_bytes, input_size - result.nb_bytes);
+            if (value.size == 0) [[unlikely]]
+                return result;
+            output[result.nb_values] = value.value;
+        }
+        ++result.nb_values;
+        result.nb_bytes = end;
+        if (((end_mask >> end) & 0xf) == 0xf)
+            return result;
+    }
+    if (result.nb_bytes < 16)
+    {
+        const varint_decode_result<uint64_t> value
+            = decode_multi_byte_varint_(input + result.nb_bytes, input_size - result.nb_bytes);
+        if (value.size != 0) [[likely]]
+        {
+            output[result.nb_values++] = value.value;
+            result.nb_bytes += value.size;
+        }
+    }
+    return result;
+}
+
+ARBA_CORE_TARGET("sse2")
+inline void widen_single_byte_varints_sse2_(__m128i bytes, uint64_t* output)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i words[2] = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        const __m128i dwords[2] = { _mm_unpacklo_epi16(words[i], zero), _mm_unpackhi_epi16(words[i], zero) };
+        for (std::size_t j = 0; j < 2; ++j)
+        {
+            uint64_t* values = output + 8 * i + 4 * j;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _mm_unpacklo_epi32(dwords[j], zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values + 2), _mm_unpackhi_epi32(dwords[j], zero));
+        }
+    }
+}
+
+ARBA_CORE_TARGET("sse2")
+inline void widen_two_byte_varints_sse2_(__m128i bytes, uint64_t* output)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i words = _mm_or_si128(_mm_and_si128(bytes, _mm_set1_epi16(0x007f)),
+                                       _mm_and_si128(_mm_srli_epi16(bytes, 1), _mm_set1_epi16(0x3f80)));
+    const __m128i dwords[2] = { _mm_unpacklo_epi16(words, zero), _mm_unpackhi_epi16(words, zero) };
+    for (std::size_t j = 0; j < 2; ++j)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 4 * j), _mm_unpacklo_epi32(dwords[j], zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 4 * j + 2), _mm_unpackhi_epi32(dwords[j], zero));
+    }
+}
+
+ARBA_CORE_TARGET("sse2")
+inline varints_decode_result decode_varints_sse2_(const std::byte* input, std::size_t input_size, uint64_t* output,
+                                                  std::size_t output_size)
+{
+    varints_decode_result result;
+    while (input_size - result.nb_bytes >= 16 && output_size - result.nb_values >= 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + result.nb_bytes));
+        const unsigned end_mask = ~static_cast<unsigned>(_mm_movemask_epi8(chunk)) & 0xffff;
+        if (end_mask == 0xaaaa)
+        {
+            widen_two_byte_varints_sse2_(chunk, output + result.nb_values);
+            result.nb_values += 8;
+            result.nb_bytes += 16;
+            continue;
+        }
+        const auto nb_single_byte_values = static_cast<std::size_t>(std::countr_one(end_mask));
+        if (nb_single_byte_values > 0)
+        {
+            widen_single_byte_varints_sse2_(chunk, output + result.nb_values);
+            if (nb_single_byte_values == 16)
+            {
+                result.nb_values += 16;
+                result.nb_bytes += 16;
+                continue;
+            }
+        }
+        const varints_decode_result chunk_result
+            = decode_chunk_varints_(input + result.nb_bytes, input_size - result.nb_bytes, end_mask,
+                                    nb_single_byte_values, output + result.nb_values);
+        if (chunk_result.nb_bytes == 0) [[unlikely]]
+            return result;
+        result.nb_values += chunk_result.nb_values;
+        result.nb_bytes += chunk_result.nb_bytes;
+    }
+    const varints_decode_result tail_result
+        = decode_varints_scalar_(input + result.nb_bytes, input_size - result.nb_bytes, output + result.nb_values,
+                                 output_size - result.nb_values);
+    return { result.nb_values + tail_result.nb_values, result.nb_bytes + tail_result.nb_bytes };
+}
+
+ARBA_CORE_TARGET("avx2")
+inline void widen_single_byte_varints_avx2_(__m128i bytes, uint64_t* output)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_cvtepu8_epi64(bytes));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 4), _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 4)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 8), _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 8)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 12), _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 12)));
+}
+
+ARBA_CORE_TARGET("avx2")
+inline void widen_two_byte_varints_avx2_(__m128i bytes, uint64_t* output)
+{
+    const __m128i words = _mm_or_si128(_mm_and_si128(bytes, _mm_set1_epi16(0x007f)),
+                                       _mm_and_si128(_mm_srli_epi16(bytes, 1), _mm_set1_epi16(0x3f80)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_cvtepu16_epi64(words));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 4), _mm256_cvtepu16_epi64(_mm_srli_si128(words, 8)));
+}
+
+ARBA_CORE_TARGET("avx2,bmi")
+inline varints_decode_result decode_varints_avx2_(const std::byte* input, std::size_t input_size, uint64_t* output,
+                                                  std::size_t output_size)
+{
+    varints_decode_result result;
+    while (input_size - result.nb_bytes >= 16 && output_size - result.nb_values >= 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + result.nb_bytes));
+        const unsigned end_mask = ~static_cast<unsigned>(_mm_movemask_epi8(chunk)) & 0xffff;
+        if (end_mask == 0xaaaa)
+        {
+            widen_two_byte_varints_avx2_(chunk, output + result.nb_values);
+            result.nb_values += 8;
+            result.nb_bytes += 16;
+            continue;
+        }
+        const auto nb_single_byte_values = static_cast<std::size_t>(std::countr_one(end_mask));
+        if (nb_single_byte_values > 0)
+        {
+            widen_single_byte_varints_avx2_(chunk, output + result.nb_values);
+            if (nb_single_byte_values == 16)
+            {
+                result.nb_values += 16;
+                result.nb_bytes += 16;
+                continue;
+            }
+        }
+        const varints_decode_result chunk_result
+            = decode_chunk_varints_(input + result.nb_bytes, input_size - result.nb_bytes, end_mask,
+                                    nb_single_byte_values, output + result.nb_values);
+        if (chunk_result.nb_bytes == 0) [[unlikely]]
+            return result;
+        result.nb_values += chunk_result.nb_values;
+        result.nb_bytes += chunk_result.nb_bytes;
+    }
+    const varints_decode_result tail_result
+        = decode_varints_scalar_(input + result.nb_bytes, input_size - result.nb_bytes, output + result.nb_values,
+                                 output_size - result.nb_values);
+    return { result.nb_values + tail_result.nb_values, result.nb_bytes + tail_result.nb_bytes };
+}
+#endif
+
+inline constexpr auto decode_varints_ = simd_dispatcher(&decode_varints_scalar_)
+#if defined(ARBA_CORE_SIMD_X86)
+                                            .with(simd_level::sse2, &decode_varints_sse2_)
+                                            .with(simd_level::avx2, &decode_varints_avx2_)
+#endif
+    ;
+} // namespace private_
+
+// Single values:
+
+// Writes value as a varint at the beginning of output, which must be large enough, and returns its size.
+template <std::unsigned_integral T>
+inline constexpr std::size_t encode_varint(T value, std::span<std::byte> output)
+{
+    return private_::encode_varint_(value, output.data());
+}
+
+template <std::unsigned_integral T>
+inline constexpr std::size_t encode_varint(T value, std::span<std::byte> output, cppx::maythrow_t)
+{
+    if (output.size() < varint_size(value)) [[unlikely]]
+        throw std::length_error("Output span is too small for the varint.");
+    return private_::encode_varint_(value, output.data());
+}
+
+template <std::unsigned_integral T = uint64_t>
+[[nodiscard]] inline constexpr varint_decode_result<T> decode_varint(std::span<const std::byte> input)
+{
+    return private_::decode_varint_<T>(input.data(), input.size());
+}
+
+template <std::unsigned_integral T = uint64_t>
+[[nodiscard]] inline constexpr varint_decode_result<T> decode_varint(std::span<const std::byte> input,
+                                                                     cppx::maythrow_t)
+{
+    const varint_decode_result<T> result = private_::decode_varint_<T>(input.data(), input.size());
+    if (result.size == 0) [[unlikely]]
+        throw std::invalid_argument("Input bytes do not start with a valid varint.");
+    return result;
+}
+
+// Spans:
+
+// Writes the values as consecutive varints to output and returns the number of bytes written.
+// Throws std::length_error if output is too small.
+template <std::unsigned_integral T>
+inline std::size_t encode_varints(std::span<const std::type_identity_t<T>> values, std::span<std::byte> output)
+{
+    std::size_t nb_bytes = 0;
+    for (const T value : values)
+    {
+        const std::size_t remaining_size = output.size() - nb_bytes;
+        if (remaining_size < max_varint_size<T> && remaining_size < varint_size(value)) [[unlikely]]
+            throw std::length_error("Output span is too small for the varints.");
+        nb_bytes += private_::encode_varint_(value, output.data() + nb_bytes);
+    }
+    return nb_bytes;
+}
+
+// Decodes consecutive varints from input until output is full, input is exhausted, or a varint is truncated
+// or malformed. Uses the best SIMD kernel available.
+// The values of output after the decoded ones may be overwritten.
+inline varints_decode_result decode_varints(std::span<const std::byte> input, std::span<uint64_t> output)
+{
+    return private_::decode_varints_(input.data(), input.size(), output.data(), output.size());
+}
+
+} // namespace core
+} // namespace arba
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <arba/core/bit/endian_value.hpp>
+#include <arba/core/bit/load_store.hpp>
+#include <arba/cppx/policy/exception_policy.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <stdexcept>
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief The binary_reader class is a cursor deserializing values stored in Endianness byte order in a byte span.
+ *
+ * Like load_be() and load_le(), reads are unchecked by default; the cppx::maythrow overloads throw std::out_of_range
+ * if the span holds too few bytes. To check a whole message at once, call require() with its size, then read its
+ * fields unchecked.
+ */
+template <std::endian Endianness = std::endian::big>
+class binary_reader
+{
+public:
+    static constexpr std::endian endianness = Endianness;
+
+    explicit binary_reader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    [[nodiscard]] inline std::size_t position() const { return position_; }
+    [[nodiscard]] inline std::size_t remaining_size() const { return bytes_.size() - position_; }
+    [[nodiscard]] inline bool empty() const { return position_ == bytes_.size(); }
+    [[nodiscard]] inline std::span<const std::byte> remaining_bytes() const { return bytes_.subspan(position_); }
+
+    // Throws std::out_of_range if fewer than size bytes remain.
+    inline void require(std::size_t size) const
+    {
+        if (remaining_size() < size) [[unlikely]]
+            throw std::out_of_range("Binary reader has not enough bytes left.");
+    }
+
+    inline void seek(std::size_t position) { position_ = position; }
+
+    inline void seek(std::size_t position, cppx::maythrow_t)
+    {
+        if (position > bytes_.size()) [[unlikely]]
+            throw std::out_of_range("Binary reader position is out of the bytes range.");
+        position_ = position;
+    }
+
+    inline void skip(std::size_t size) { position_ += size; }
+
+    inline void skip(std::size_t size, cppx::maythrow_t)
+    {
+        require(size);
+        position_ += size;
+    }
+
+    template <EndianLoadable T>
+    [[nodiscard]] inline T read()
+    {
+        return read<T>(std::nothrow);
+    }
+
+    template <EndianLoadable T>
+    [[nodiscard]] inline T read(cppx::maythrow_t)
+    {
+        require(sizeof(T));
+        return read<T>(std::nothrow);
+    }
+
+    template <EndianLoadable T>
+    [[nodiscard]] inline T read(std::nothrow_t)
+    {
+        const T value = private_::load_<Endianness, T>(bytes_.data() + position_);
+        position_ += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> && (!std::is_const_v<T>) && (sizeof(T) == 1 || BulkByteSwappable<T>)
+    inline void read(std::span<T> values)
+    {
+        read(values, std::nothrow);
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> && (!std::is_const_v<T>) && (sizeof(T) == 1 || BulkByteSwappable<T>)
+    inline void read(std::span<T> values, cppx::maythrow_t)
+    {
+        require(values.size_bytes());
+        read(values, std::nothrow);
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> && (!std::is_const_v<T>) && (sizeof(T) == 1 || BulkByteSwappable<T>)
+    inline void read(std::span<T> values, std::nothrow_t)
+    {
+        private_::endian_copy_values_<T, Endianness>(bytes_.data() + position_,
+                                                     reinterpret_cast<std::byte*>(values.data()), values.size());
+        position_ += values.size_bytes();
+    }
+
+    // Returns the next size bytes, without copying them.
+    [[nodiscard]] inline std::span<const std::byte> read_bytes(std::size_t size)
+    {
+        return read_bytes(size, std::nothrow);
+    }
+
+    [[nodiscard]] inline std::span<const std::byte> read_bytes(std::size_t size, cppx::maythrow_t)
+    {
+        require(size);
+        return read_bytes(size, std::nothrow);
+    }
+
+    [[nodiscard]] inline std::span<const std::byte> read_bytes(std::size_t size, std::nothrow_t)
+    {
+        const std::span<const std::byte> bytes = bytes_.subspan(position_, size);
+        position_ += size;
+        return bytes;
+    }
+
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t position_ = 0;
+};
+
+} // namespace core
+} // namespace arba
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <arba/core/bit/endian_value.hpp>
+#include <arba/core/bit/load_store.hpp>
+#include <arba/cppx/policy/exception_policy.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief The binary_writer class serializes values in Endianness byte order, appending them to a byte buffer.
+ *
+ * The buffer is either a caller-provided span, whose size cannot change, or a vector, which grows as needed and
+ * is trimmed to the written bytes when the writer is destroyed.
+ *
+ * Like store_be() and store_le(), writes are unchecked by default; the cppx::maythrow overloads make room for the
+ * value first. To make room for a whole message at once, call reserve() with its size, then write its fields
+ * unchecked.
+ * @code
+ * std::vector<std::byte> buffer;
+ * {
+ *     core::binary_writer writer(buffer);
+ *     writer.reserve(sizeof(uint32_t) + sizeof(uint16_t));
+ *     writer.write(uint32_t(42));
+ *     writer.write(uint16_t(7));
+ *     writer.write(uint8_t(1), cppx::maythrow);
+ * }
+ * @endcode
+ */
+template <std::endian Endianness = std::endian::big>
+class binary_writer
+{
+public:
+    static constexpr std::endian endianness = Endianness;
+
+    explicit binary_writer(std::span<std::byte> buffer) : data_(buffer.data()), capacity_(buffer.size()) {}
+
+    explicit binary_writer(std::vector<std::byte>& buffer)
+        : vector_(&buffer), data_(buffer.data()), position_(buffer.size()), capacity_(buffer.size())
+    {
+    }
+
+    binary_writer(const binary_writer&) = delete;
+    binary_writer& operator=(const binary_writer&) = delete;
+
+    ~binary_writer()
+    {
+        if (vector_)
+            vector_->resize(position_);
+    }
+
+    [[nodiscard]] inline std::size_t position() const { return position_; }
+    [[nodiscard]] inline std::size_t remaining_capacity() const { return capacity_ - position_; }
+    [[nodiscard]] inline std::span<const std::byte> written_bytes() const { return { data_, position_ }; }
+
+    // Makes room for size more bytes: grows the vector buffer or throws std::length_error if the span buffer is
+    // too small.
+    inline void reserve(std::size_t size)
+    {
+        if (capacity_ - position_ < size) [[unlikely]]
+            grow_(size);
+    }
+
+    template <EndianLoadable T>
+    inline void write(T value)
+    {
+        write(value, std::nothrow);
+    }
+
+    template <EndianLoadable T>
+    inline void write(T value, cppx::maythrow_t)
+    {
+        reserve(sizeof(T));
+        write(value, std::nothrow);
+    }
+
+    template <EndianLoadable T>
+    inline void write(T value, std::nothrow_t)
+    {
+        private_::store_<Endianness, T>(data_ + position_, value);
+        position_ += sizeof(T);
+    }
+
+    template <typename T, std::size_t Extent>
+        requires std::is_trivially_copyable_v<T> && (sizeof(T) == 1 || BulkByteSwappable<std::remove_const_t<T>>)
+    inline void write(std::span<T, Extent> values)
+    {
+        write(values, std::nothrow);
+    }
+
+    template <typename T, std::size_t Extent>
+        requires std::is_trivially_copyable_v<T> && (sizeof(T) == 1 || BulkByteSwappable<std::remove_const_t<T>>)
+    inline void write(std::span<T, Extent> values, cppx::maythrow_t)
+    {
+        reserve(values.size_bytes());
+        write(values, std::nothrow);
+    }
+
+    template <typename T, std::size_t Extent>
+        requires std::is_trivially_copyable_v<T> && (sizeof(T) == 1 || BulkByteSwappable<std::remove_const_t<T>>)
+    inline void write(std::span<T, Extent> values, std::nothrow_t)
+    {
+        private_::endian_copy_values_<std::remove_const_t<T>, Endianness>(
+            reinterpret_cast<const std::byte*>(values.data()), data_ + position_, values.size());
+        position_ += values.size_bytes();
+    }
+
+    inline void write_bytes(std::span<const std::byte> bytes) { write(bytes); }
+    inline void write_bytes(std::span<const std::byte> bytes, cppx::maythrow_t) { write(bytes, cppx::maythrow); }
+    inline void write_bytes(std::span<const std::byte> bytes, std::nothrow_t) { write(bytes, std::nothrow); }
+
+private:
+    inline void grow_(std::size_t size)
+    {
+        if (!vector_) [[unlikely]]
+            throw std::length_error("Binary writer buffer is too small.");
+        vector_->resize(std::max(position_ + size, 2 * vector_->size()));
+        data_ = vector_->data();
+        capacity_ = vector_->size();
+    }
+
+    std::vector<std::byte>* vector_ = nullptr;
+    std::byte* data_ = nullptr;
+    std::size_t position_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+} // namespace core
+} // namespace arba
@@ -1,73 +1,189 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <format>
+#include <iterator>
+#include <string_view>
 
-template <class CharT>
-struct std::formatter<std::byte, CharT>
+inline namespace arba
 {
-    template <class FormatParseContext>
-    inline constexpr auto parse(FormatParseContext& ctx)
+namespace core
+{
+namespace private_
+{
+// Text of a byte in a given format, precomputed for the 256 values.
+struct byte_text_
+{
+    std::array<char, 8> chars{};
+    uint8_t size = 0;
+};
+
+using byte_text_table_ = std::array<byte_text_, 256>;
+
+// nb_digits is the minimal number of digits, or of characters (sign included) for signed values.
+consteval byte_text_table_ make_byte_text_table_(unsigned base, unsigned nb_digits, bool is_signed,
+                                                 std::string_view digit_chars = "0123456789abcdef")
+{
+    byte_text_table_ table;
+    for (unsigned value = 0; value < 256; ++value)
+    {
+        byte_text_& text = table[value];
+        const bool is_negative = is_signed && value >= 128;
+        unsigned magnitude = is_negative ? 256 - value : value;
+        std::array<char, 8> digits{};
+        unsigned nb_value_digits = 0;
+        do
+        {
+            digits[nb_value_digits++] = digit_chars[magnitude % base];
+            magnitude /= base;
+        } while (magnitude != 0);
+        if (is_negative)
+            text.chars[text.size++] = '-';
+        for (unsigned i = nb_value_digits + text.size; i < nb_digits; ++i)
+            text.chars[text.size++] = '0';
+        while (nb_value_digits > 0)
+            text.chars[text.size++] = digits[--nb_value_digits];
+    }
+    return table;
+}
+
+consteval byte_text_table_ make_byte_char_table_()
+{
+    byte_text_table_ table;
+    for (unsigned value = 0; value < 256; ++value)
+        table[value] = byte_text_{ { static_cast<char>(value) }, 1 };
+    return table;
+}
+
+inline constexpr byte_text_table_ byte_texts_u_ = make_byte_text_table_(10, 0, false);
+inline constexpr byte_text_table_ byte_texts_i_ = make_byte_text_table_(10, 0, true);
+inline constexpr byte_text_table_ byte_texts_x_ = make_byte_text_table_(16, 2, false);
+inline constexpr byte_text_table_ byte_texts_X_ = make_byte_text_table_(16, 2, false, "0123456789ABCDEF");
+inline constexpr byte_text_table_ byte_texts_b_ = make_byte_text_table_(2, 8, false);
+inline constexpr byte_text_table_ byte_texts_o_ = make_byte_text_table_(8, 3, false);
+inline constexpr byte_text_table_ byte_texts_c_ = make_byte_char_table_();
+inline constexpr byte_text_table_ byte_texts_0u_ = make_byte_text_table_(10, 3, false);
+inline constexpr byte_text_table_ byte_texts_0i_ = make_byte_text_table_(10, 4, true);
+
+// Finds the byte whose text in table is exactly text, the inverse of the table lookup.
+[[nodiscard]] constexpr bool parse_byte_text_(const byte_text_table_& table, std::string_view text, std::byte& byte)
+{
+    if (text.empty() || text.size() > table[0].chars.size())
+        return false;
+    unsigned value = 0;
+    if (&table == &byte_texts_c_)
+        value = static_cast<uint8_t>(text[0]);
+    else
     {
-        auto iter = ctx.begin();
-        if (iter == ctx.end())
-            return iter;
-        constexpr std::array<CharT, 7> chs = { 'u', 'i', 'x', 'b', 'o', 'c', '0' };
-        constexpr uint8_t zero_ch_index = 6;
-        auto find_iter = std::ranges::find(chs, *iter);
-        if (find_iter == chs.end()) [[unlikely]]
-            return iter;
-        const uint8_t index = static_cast<uint8_t>(find_iter - chs.begin());
-        if (index < zero_ch_index)
+        const unsigned base = &table == &byte_texts_x_ || &table == &byte_texts_X_ ? 16
+                              : &table == &byte_texts_b_                          ? 2
+                              : &table == &byte_texts_o_                          ? 8
+                                                                                  : 10;
+        const bool is_negative = text[0] == '-';
+        unsigned magnitude = 0;
+        for (std::size_t i = is_negative ? 1 : 0; i < text.size(); ++i)
         {
-            fmt_ = index;
-            return ++iter;
+            const char ch = text[i];
+            const unsigned digit = ch >= '0' && ch <= '9' ? unsigned(ch - '0')
+                                   : ch >= 'a' && ch <= 'f' ? unsigned(ch - 'a' + 10)
+                                   : ch >= 'A' && ch <= 'F' ? unsigned(ch - 'A' + 10)
+                                                            : base;
+            if (digit >= base || (magnitude = magnitude * base + digit) > 256)
+                return false;
         }
+        value = is_negative ? (256 - magnitude) & 0xff : magnitude;
+        if (value > 255)
+            return false;
+    }
+    // Rejects the texts which are not the canonical one: letter case, padding, sign or out of range value.
+    const byte_text_& canonical_text = table[value];
+    if (std::string_view(canonical_text.chars.data(), canonical_text.size) != text)
+        return false;
+    byte = std::byte(value);
+    return true;
+}
+
+// Text table and prefix selected by a byte format specification.
+struct byte_text_format_
+{
+    const byte_text_table_* table = &byte_texts_u_;
+    std::string_view prefix;
+};
+
+// Parses [0](u|i|x|X|b|o|c) and returns an iterator on the first character after the specification.
+template <class Iterator>
+constexpr Iterator parse_byte_text_format_(Iterator iter, const Iterator end, byte_text_format_& format)
+{
+    using char_type = std::iter_value_t<Iterator>;
+    format = byte_text_format_{};
+    const bool has_zero = iter != end && *iter == char_type('0');
+    if (has_zero)
         ++iter;
-        constexpr uint8_t nb_zero_reps = 5;
-        const auto last_iter = chs.begin() + nb_zero_reps;
-        find_iter = std::find(chs.begin(), last_iter, *iter);
-        if (find_iter != last_iter)
+    if (iter == end || *iter == char_type('}'))
+        return iter;
+    switch (*iter)
+    {
+    case char_type('u'):
+        format.table = has_zero ? &byte_texts_0u_ : &byte_texts_u_;
+        break;
+    case char_type('i'):
+        format.table = has_zero ? &byte_texts_0i_ : &byte_texts_i_;
+        break;
+    case char_type('x'):
+        format = byte_text_format_{ &byte_texts_x_, has_zero ? "0x" : "" };
+        break;
+    case char_type('X'):
+        format = byte_text_format_{ &byte_texts_X_, has_zero ? "0X" : "" };
+        break;
+    case char_type('b'):
+        format = byte_text_format_{ &byte_texts_b_, has_zero ? "0b" : "" };
+        break;
+    case char_type('o'):
+        format = byte_text_format_{ &byte_texts_o_, has_zero ? "0o" : "" };
+        break;
+    case char_type('c'):
+        if (!has_zero) [[likely]]
         {
-            fmt_ = static_cast<uint8_t>(find_iter - chs.begin()) + zero_ch_index;
-            ++iter;
+            format.table = &byte_texts_c_;
+            break;
         }
+        [[fallthrough]];
+    default:
+        throw std::format_error("Invalid byte format specification.");
+    }
+    return ++iter;
+}
+} // namespace private_
+} // namespace core
+} // namespace arba
+
+/**
+ * Format specification: [0](u|i|x|X|b|o|c), the 0 padding numbers to a fixed width (u, i) or adding a base prefix
+ * (x, X, b, o). Invalid specifications are rejected when parsing, at compile time for std::format.
+ */
+template <class CharT>
+struct std::formatter<std::byte, CharT>
+{
+    template <class FormatParseContext>
+    inline constexpr auto parse(FormatParseContext& ctx)
+    {
+        auto iter = core::private_::parse_byte_text_format_(ctx.begin(), ctx.end(), format_);
+        if (iter != ctx.end() && *iter != CharT('}')) [[unlikely]]
+            throw std::format_error("Invalid byte format specification.");
         return iter;
     }
 
     template <class FormatContext>
-    auto format(const std::byte& arg, FormatContext& ctx) const
+    inline auto format(const std::byte& arg, FormatContext& ctx) const
     {
-        switch (fmt_)
-        {
-        case 0: // u
-            return std::format_to(ctx.out(), "{}", static_cast<uint8_t>(arg));
-        case 1: // i
-            return std::format_to(ctx.out(), "{}", static_cast<int8_t>(arg));
-        case 2: // x
-            return std::format_to(ctx.out(), "{:02x}", static_cast<uint8_t>(arg));
-        case 3: // b
-            return std::format_to(ctx.out(), "{:08b}", static_cast<uint8_t>(arg));
-        case 4: // o
-            return std::format_to(ctx.out(), "{:03o}", static_cast<uint8_t>(arg));
-        case 5: // c
-            return std::format_to(ctx.out(), "{}", static_cast<char>(arg));
-        case 6: // 0u
-            return std::format_to(ctx.out(), "{:03d}", static_cast<uint8_t>(arg));
-        case 7: // 0i
-            return std::format_to(ctx.out(), "{:04d}", static_cast<int8_t>(arg));
-        case 8: // 0x
-            return std::format_to(ctx.out(), "0x{:02x}", static_cast<uint8_t>(arg));
-        case 9: // 0b
-            return std::format_to(ctx.out(), "0b{:08b}", static_cast<uint8_t>(arg));
-        case 10: // 0o
-            return std::format_to(ctx.out(), "0o{:03o}", static_cast<uint8_t>(arg));
-        }
-        throw std::runtime_error(std::format("Unrecognized byte formatting: {}", fmt_));
+        const core::private_::byte_text_& text = (*format_.table)[static_cast<uint8_t>(arg)];
+        auto out = std::ranges::copy(format_.prefix, ctx.out()).out;
+        return std::copy_n(text.chars.data(), text.size, out);
     }
 
 private:
-    uint8_t fmt_ = 0;
+    core::private_::byte_text_format_ format_;
 };
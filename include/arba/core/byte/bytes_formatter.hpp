@@ -2,15 +2,43 @@
 
 #include "byte.hpp"
 
+#include <arba/core/simd/simd_dispatcher.hpp>
 #include <arba/meta/type_traits/kwargs.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <format>
 #include <fstream>
 #include <optional>
+#include <semaphore>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARBA_CORE_HAS_POSIX_IO 1
+#endif
 
 inline namespace arba
 {
@@ -27,6 +55,7 @@ ARBA_META_KWARG(chunk_beginning, std::string);
 ARBA_META_KWARG(chunk_end, std::string);
 ARBA_META_KWARG(nb_units_per_chunk, uint32_t);
 ARBA_META_KWARG(force_chunk_end, bool);
+ARBA_META_KWARG(nb_threads, uint32_t);
 
 } // namespace bytes_formatter_kwargs
 
@@ -35,11 +64,905 @@ concept BytesFormatterKwarg =
     meta::Kwarg<T, bytes_formatter_kwargs::unit_format, bytes_formatter_kwargs::unit_sep,
                 bytes_formatter_kwargs::seq_beginning, bytes_formatter_kwargs::seq_end,
                 bytes_formatter_kwargs::chunk_beginning, bytes_formatter_kwargs::chunk_end,
-                bytes_formatter_kwargs::nb_units_per_chunk, bytes_formatter_kwargs::force_chunk_end>;
+                bytes_formatter_kwargs::nb_units_per_chunk, bytes_formatter_kwargs::force_chunk_end,
+                bytes_formatter_kwargs::nb_threads>;
+
+#if defined(ARBA_CORE_HAS_POSIX_IO)
+/**
+ * @brief POSIX file descriptor used as output of a bytes_formatter.
+ */
+struct fd_output
+{
+    int fd;
+};
+#endif
+
+/**
+ * @brief Output of a bytes_formatter: an output stream, a std::string or std::vector<char> to append to, a FILE*,
+ * a POSIX file descriptor (fd_output), or a char output iterator (as for std::format_to).
+ */
+template <class Output>
+concept BytesFormatterOutput = std::derived_from<std::remove_cvref_t<Output>, std::ostream>
+                               || std::same_as<Output, std::string&> || std::same_as<Output, std::vector<char>&>
+                               || std::same_as<std::remove_cvref_t<Output>, FILE*>
+#if defined(ARBA_CORE_HAS_POSIX_IO)
+                               || std::same_as<std::remove_cvref_t<Output>, fd_output>
+#endif
+                               || std::output_iterator<std::remove_cvref_t<Output>, char>;
+
+namespace private_
+{
+template <class Text>
+inline void append_text_(Text& text, std::string_view str)
+{
+    if constexpr (requires { text.append(str); })
+        text.append(str);
+    else
+        text.insert(text.end(), str.begin(), str.end());
+}
+
+// Output iterator comparing the characters written through it with those of a text, to match a formatted text
+// without storing it.
+class text_matching_iterator_
+{
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    text_matching_iterator_() = default;
+    explicit text_matching_iterator_(std::string_view text) : text_(text) {}
+
+    // @return True if the characters written so far begin text.
+    [[nodiscard]] inline bool matches() const { return matches_; }
+    [[nodiscard]] inline std::size_t nb_written_chars() const { return nb_written_chars_; }
+
+    inline text_matching_iterator_& operator=(char ch)
+    {
+        matches_ = matches_ && nb_written_chars_ < text_.size() && text_[nb_written_chars_] == ch;
+        ++nb_written_chars_;
+        return *this;
+    }
+    inline text_matching_iterator_& operator*() { return *this; }
+    inline text_matching_iterator_& operator++() { return *this; }
+    inline text_matching_iterator_& operator++(int) { return *this; }
+
+private:
+    std::string_view text_;
+    std::size_t nb_written_chars_ = 0;
+    bool matches_ = true;
+};
+
+// Unit format parsed once into literal texts and byte or unit index fields.
+class unit_format_plan_
+{
+public:
+    unit_format_plan_() = default;
+    explicit unit_format_plan_(std::string_view unit_format);
+
+    template <class Text>
+    void append_to(Text& text, std::byte byte, std::size_t unit_index) const;
+
+    // The byte format if the unit format is a lone byte field, nullptr otherwise.
+    [[nodiscard]] const byte_text_format_* lone_byte_format() const
+    {
+        const bool is_lone_byte = segments_.size() == 1 && segments_[0].literal.empty()
+                                  && segments_[0].field == field_kind_::byte;
+        return is_lone_byte ? &segments_[0].byte_format : nullptr;
+    }
+
+    [[nodiscard]] bool has_byte_field() const
+    {
+        return std::ranges::any_of(segments_, [](const segment_& segment)
+                                   { return segment.field == field_kind_::byte; });
+    }
+
+    /**
+     * Matches the text of a unit at the beginning of text, its unit index fields against unit_index.
+     * @return The size of the unit text, or std::string_view::npos if text does not begin with a unit.
+     */
+    [[nodiscard]] std::size_t match(std::string_view text, std::size_t unit_index, std::byte& byte) const
+    {
+        std::optional<std::byte> matched_byte;
+        const std::size_t size = match_segments_(0, text, 0, unit_index, matched_byte);
+        if (matched_byte)
+            byte = *matched_byte;
+        return size;
+    }
+
+private:
+    enum class field_kind_ : uint8_t
+    {
+        none,
+        byte,
+        unit_index,
+    };
+
+    struct segment_
+    {
+        std::string literal;
+        field_kind_ field = field_kind_::none;
+        byte_text_format_ byte_format;
+        std::string unit_index_format;
+    };
+
+    void parse_field_(std::string_view field, std::size_t& next_arg_id, bool& uses_manual_ids, segment_& segment);
+    template <class Text>
+    static void append_unit_index_to_(Text& text, const segment_& segment, std::size_t unit_index);
+    static std::size_t match_unit_index_(std::string_view text, const segment_& segment, std::size_t unit_index);
+    std::size_t match_segments_(std::size_t segment_index, std::string_view text, std::size_t pos,
+                                std::size_t unit_index, std::optional<std::byte>& byte) const;
+
+private:
+    std::vector<segment_> segments_;
+};
+
+inline unit_format_plan_::unit_format_plan_(std::string_view unit_format)
+{
+    std::size_t next_arg_id = 0;
+    bool uses_manual_ids = false;
+    segment_ segment;
+    for (std::size_t i = 0; i < unit_format.size(); ++i)
+    {
+        const char ch = unit_format[i];
+        if ((ch == '{' || ch == '}') && i + 1 < unit_format.size() && unit_format[i + 1] == ch)
+        {
+            segment.literal.push_back(ch);
+            ++i;
+        }
+        else if (ch == '{')
+        {
+            const std::size_t field_end = unit_format.find_first_of("{}", i + 1);
+            if (field_end == std::string_view::npos || unit_format[field_end] != '}') [[unlikely]]
+                throw std::format_error("Invalid unit format: unmatched '{' or nested replacement field.");
+            parse_field_(unit_format.substr(i + 1, field_end - i - 1), next_arg_id, uses_manual_ids, segment);
+            segments_.push_back(std::move(segment));
+            segment = segment_{};
+            i = field_end;
+        }
+        else if (ch == '}') [[unlikely]]
+            throw std::format_error("Invalid unit format: unmatched '}'.");
+        else
+            segment.literal.push_back(ch);
+    }
+    if (!segment.literal.empty())
+        segments_.push_back(std::move(segment));
+}
+
+inline void unit_format_plan_::parse_field_(std::string_view field, std::size_t& next_arg_id, bool& uses_manual_ids,
+                                            segment_& segment)
+{
+    const std::size_t colon_pos = std::min(field.find(':'), field.size());
+    const std::string_view arg_id_text = field.substr(0, colon_pos);
+    const std::string_view spec = field.substr(std::min(colon_pos + 1, field.size()));
+    std::size_t arg_id = 0;
+    if (arg_id_text.empty())
+    {
+        if (uses_manual_ids) [[unlikely]]
+            throw std::format_error("Invalid unit format: automatic and manual argument indexing are mixed.");
+        arg_id = next_arg_id++;
+    }
+    else
+    {
+        if (next_arg_id > 0) [[unlikely]]
+            throw std::format_error("Invalid unit format: automatic and manual argument indexing are mixed.");
+        uses_manual_ids = true;
+        const auto result = std::from_chars(arg_id_text.data(), arg_id_text.data() + arg_id_text.size(), arg_id);
+        if (result.ec != std::errc() || result.ptr != arg_id_text.data() + arg_id_text.size()) [[unlikely]]
+            throw std::format_error("Invalid unit format: bad argument index.");
+    }
+
+    if (arg_id == 0)
+    {
+        segment.field = field_kind_::byte;
+        if (private_::parse_byte_text_format_(spec.begin(), spec.end(), segment.byte_format) != spec.end())
+            [[unlikely]]
+            throw std::format_error("Invalid byte format specification.");
+    }
+    else if (arg_id == 1)
+    {
+        segment.field = field_kind_::unit_index;
+        if (!spec.empty())
+        {
+            segment.unit_index_format = std::string("{:").append(spec).append("}");
+            const std::size_t unit_index = 0;
+            std::ignore = std::vformat(segment.unit_index_format, std::make_format_args(unit_index));
+        }
+    }
+    else [[unlikely]]
+        throw std::format_error("Invalid unit format: argument index out of range.");
+}
+
+template <class Text>
+inline void unit_format_plan_::append_to(Text& text, std::byte byte, std::size_t unit_index) const
+{
+    for (const segment_& segment : segments_)
+    {
+        append_text_(text, segment.literal);
+        switch (segment.field)
+        {
+        case field_kind_::byte:
+        {
+            const byte_text_& byte_text = (*segment.byte_format.table)[static_cast<uint8_t>(byte)];
+            append_text_(text, segment.byte_format.prefix);
+            append_text_(text, std::string_view(byte_text.chars.data(), byte_text.size));
+            break;
+        }
+        case field_kind_::unit_index:
+            append_unit_index_to_(text, segment, unit_index);
+            break;
+        case field_kind_::none:
+            break;
+        }
+    }
+}
+
+template <class Text>
+inline void unit_format_plan_::append_unit_index_to_(Text& text, const segment_& segment, std::size_t unit_index)
+{
+    if (segment.unit_index_format.empty())
+    {
+        std::array<char, 20> digits;
+        const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), unit_index);
+        append_text_(text, std::string_view(digits.data(), result.ptr));
+    }
+    else
+        std::vformat_to(std::back_inserter(text), segment.unit_index_format, std::make_format_args(unit_index));
+}
+
+// The text of unit_index is not stored in a string: this is called for each unit when parsing.
+// @return The size of the text of unit_index at the beginning of text, or std::string_view::npos if text does not
+// begin with it.
+inline std::size_t unit_format_plan_::match_unit_index_(std::string_view text, const segment_& segment,
+                                                        std::size_t unit_index)
+{
+    if (segment.unit_index_format.empty())
+    {
+        std::array<char, 20> digits;
+        const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), unit_index);
+        const std::string_view unit_index_text(digits.data(), result.ptr);
+        return text.starts_with(unit_index_text) ? unit_index_text.size() : std::string_view::npos;
+    }
+    const text_matching_iterator_ end = std::vformat_to(text_matching_iterator_(text), segment.unit_index_format,
+                                                        std::make_format_args(unit_index));
+    return end.matches() ? end.nb_written_chars() : std::string_view::npos;
+}
+
+// Byte fields of variable size are tried from their longest text, backtracking when the rest of the unit does not
+// match. All the byte fields of a unit must match the same byte.
+inline std::size_t unit_format_plan_::match_segments_(std::size_t segment_index, std::string_view text,
+                                                      std::size_t pos, std::size_t unit_index,
+                                                      std::optional<std::byte>& byte) const
+{
+    if (segment_index == segments_.size())
+        return pos;
+    const segment_& segment = segments_[segment_index];
+    if (!text.substr(pos).starts_with(segment.literal))
+        return std::string_view::npos;
+    pos += segment.literal.size();
+    switch (segment.field)
+    {
+    case field_kind_::byte:
+    {
+        if (!text.substr(pos).starts_with(segment.byte_format.prefix))
+            return std::string_view::npos;
+        pos += segment.byte_format.prefix.size();
+        const std::optional<std::byte> previous_byte = byte;
+        for (std::size_t size = std::min(text.size() - pos, sizeof(byte_text_::chars)); size > 0; --size)
+        {
+            std::byte candidate{};
+            if (!parse_byte_text_(*segment.byte_format.table, text.substr(pos, size), candidate)
+                || (previous_byte && *previous_byte != candidate))
+                continue;
+            byte = candidate;
+            if (const std::size_t end = match_segments_(segment_index + 1, text, pos + size, unit_index, byte);
+                end != std::string_view::npos)
+                return end;
+        }
+        byte = previous_byte;
+        return std::string_view::npos;
+    }
+    case field_kind_::unit_index:
+    {
+        const std::size_t size = match_unit_index_(text.substr(pos), segment, unit_index);
+        if (size == std::string_view::npos)
+            return std::string_view::npos;
+        pos += size;
+        break;
+    }
+    case field_kind_::none:
+        break;
+    }
+    return match_segments_(segment_index + 1, text, pos, unit_index, byte);
+}
+
+// Section: Digit units
+
+// Layout of units made of the hexadecimal or binary digits of a byte, between a fixed prefix and a fixed separator.
+struct digit_unit_layout_
+{
+    static constexpr std::size_t max_stride = 16;
+    // Hexadecimal units up to this size are encoded with SIMD shuffles.
+    static constexpr std::size_t max_simd_stride = 8;
+
+    const char* hex_digits = nullptr; // nullptr for binary digits.
+    uint8_t stride = 0;
+    uint8_t digits_pos = 0;
+    std::array<char, max_stride> pattern{};
+    // For each 16-char output register of 16 units: shuffles of the digits of units 0-7 and 8-15, and constant chars.
+    std::array<std::array<uint8_t, 16>, max_simd_stride> low_units_shuffles{};
+    std::array<std::array<uint8_t, 16>, max_simd_stride> high_units_shuffles{};
+    std::array<std::array<char, 16>, max_simd_stride> constant_chars{};
+};
+
+inline std::optional<digit_unit_layout_> make_digit_unit_layout_(const byte_text_format_* byte_format,
+                                                                 std::string_view unit_sep)
+{
+    if (byte_format == nullptr)
+        return std::nullopt;
+    digit_unit_layout_ layout;
+    std::size_t nb_digits = 2;
+    if (byte_format->table == &byte_texts_x_)
+        layout.hex_digits = "0123456789abcdef";
+    else if (byte_format->table == &byte_texts_X_)
+        layout.hex_digits = "0123456789ABCDEF";
+    else if (byte_format->table == &byte_texts_b_)
+        nb_digits = 8;
+    else
+        return std::nullopt;
+    const std::size_t stride = byte_format->prefix.size() + nb_digits + unit_sep.size();
+    if (stride > digit_unit_layout_::max_stride)
+        return std::nullopt;
+
+    layout.stride = static_cast<uint8_t>(stride);
+    layout.digits_pos = static_cast<uint8_t>(byte_format->prefix.size());
+    std::ranges::copy(byte_format->prefix, layout.pattern.begin());
+    std::ranges::copy(unit_sep, layout.pattern.begin() + layout.digits_pos + nb_digits);
+    if (layout.hex_digits == nullptr || stride > digit_unit_layout_::max_simd_stride)
+        return layout;
+
+    for (std::size_t r = 0; r < stride; ++r)
+    {
+        for (std::size_t k = 0; k < 16; ++k)
+        {
+            const std::size_t unit_pos = (16 * r + k) / stride;
+            const std::size_t char_pos = (16 * r + k) % stride;
+            layout.low_units_shuffles[r][k] = 0x80;
+            layout.high_units_shuffles[r][k] = 0x80;
+            if (char_pos - layout.digits_pos < 2)
+            {
+                const std::size_t digit_pos = 2 * unit_pos + char_pos - layout.digits_pos;
+                if (digit_pos < 16)
+                    layout.low_units_shuffles[r][k] = static_cast<uint8_t>(digit_pos);
+                else
+                    layout.high_units_shuffles[r][k] = static_cast<uint8_t>(digit_pos - 16);
+            }
+            else
+                layout.constant_chars[r][k] = layout.pattern[char_pos];
+        }
+    }
+    return layout;
+}
+
+inline void encode_hex_units_scalar_(const std::byte* bytes, std::size_t nb_units, char* output,
+                                     const digit_unit_layout_& layout)
+{
+    for (std::size_t i = 0; i < nb_units; ++i, output += layout.stride)
+    {
+        const uint8_t byte = static_cast<uint8_t>(bytes[i]);
+        std::memcpy(output, layout.pattern.data(), layout.stride);
+        output[layout.digits_pos] = layout.hex_digits[byte >> 4];
+        output[layout.digits_pos + 1] = layout.hex_digits[byte & 0x0f];
+    }
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+// Digits come from a 16-entry lookup table indexed by nibbles, then are spread between the constant chars of the
+// units with shuffles.
+ARBA_CORE_TARGET("ssse3")
+inline void encode_hex_units_ssse3_(const std::byte* bytes, std::size_t nb_units, char* output,
+                                    const digit_unit_layout_& layout)
+{
+    if (layout.stride > digit_unit_layout_::max_simd_stride)
+        return encode_hex_units_scalar_(bytes, nb_units, output, layout);
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.hex_digits));
+    const __m128i low_nibble_mask = _mm_set1_epi8(0x0f);
+    std::size_t i = 0;
+    for (; nb_units - i >= 16; i += 16, output += 16 * layout.stride)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        const __m128i high_digits =
+            _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(block, 4), low_nibble_mask));
+        const __m128i low_digits = _mm_shuffle_epi8(digits, _mm_and_si128(block, low_nibble_mask));
+        const __m128i low_units = _mm_unpacklo_epi8(high_digits, low_digits);
+        const __m128i high_units = _mm_unpackhi_epi8(high_digits, low_digits);
+        for (std::size_t r = 0; r < layout.stride; ++r)
+        {
+            const __m128i chars = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(low_units, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                                             layout.low_units_shuffles[r].data()))),
+                             _mm_shuffle_epi8(high_units, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                                              layout.high_units_shuffles[r].data())))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.constant_chars[r].data())));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16 * r), chars);
+        }
+    }
+    encode_hex_units_scalar_(bytes + i, nb_units - i, output, layout);
+}
+
+// Same as SSSE3 on 32 units: the 128-bit lanes hold units 0-15 and 16-31, which are shuffled in parallel.
+ARBA_CORE_TARGET("avx2")
+inline void encode_hex_units_avx2_(const std::byte* bytes, std::size_t nb_units, char* output,
+                                   const digit_unit_layout_& layout)
+{
+    if (layout.stride > digit_unit_layout_::max_simd_stride)
+        return encode_hex_units_scalar_(bytes, nb_units, output, layout);
+    const __m256i digits =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.hex_digits)));
+    const __m256i low_nibble_mask = _mm256_set1_epi8(0x0f);
+    const std::size_t lane_size = 16 * layout.stride;
+    std::size_t i = 0;
+    for (; nb_units - i >= 32; i += 32, output += 2 * lane_size)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        const __m256i high_digits =
+            _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibble_mask));
+        const __m256i low_digits = _mm256_shuffle_epi8(digits, _mm256_and_si256(block, low_nibble_mask));
+        const __m256i low_units = _mm256_unpacklo_epi8(high_digits, low_digits);
+        const __m256i high_units = _mm256_unpackhi_epi8(high_digits, low_digits);
+        for (std::size_t r = 0; r < layout.stride; ++r)
+        {
+            const __m256i low_units_shuffle = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.low_units_shuffles[r].data())));
+            const __m256i high_units_shuffle = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.high_units_shuffles[r].data())));
+            const __m256i constant_chars = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.constant_chars[r].data())));
+            const __m256i chars = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(low_units, low_units_shuffle),
+                                                                  _mm256_shuffle_epi8(high_units, high_units_shuffle)),
+                                                  constant_chars);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16 * r), _mm256_castsi256_si128(chars));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + lane_size + 16 * r),
+                             _mm256_extracti128_si256(chars, 1));
+        }
+    }
+    encode_hex_units_ssse3_(bytes + i, nb_units - i, output, layout);
+}
+#endif
+
+inline constexpr auto encode_hex_units_ = simd_dispatcher(&encode_hex_units_scalar_)
+#if defined(ARBA_CORE_SIMD_X86)
+                                              .with(simd_level::ssse3, &encode_hex_units_ssse3_)
+                                              .with(simd_level::avx2, &encode_hex_units_avx2_)
+#endif
+    ;
+
+// The eight digits of a byte are computed at once in a 64-bit word, one char per byte.
+inline void encode_binary_units_(const std::byte* bytes, std::size_t nb_units, char* output,
+                                 const digit_unit_layout_& layout)
+{
+    constexpr uint64_t bit_masks =
+        std::endian::native == std::endian::little ? 0x0102040810204080ULL : 0x8040201008040201ULL;
+    for (std::size_t i = 0; i < nb_units; ++i, output += layout.stride)
+    {
+        const uint64_t bits = (static_cast<uint64_t>(bytes[i]) * 0x0101010101010101ULL) & bit_masks;
+        const uint64_t digits = (((bits + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL) + 0x3030303030303030ULL;
+        std::memcpy(output, layout.pattern.data(), layout.stride);
+        std::memcpy(output + layout.digits_pos, &digits, sizeof(digits));
+    }
+}
+
+using encode_digit_units_function_ = void(const std::byte*, std::size_t, char*, const digit_unit_layout_&);
+
+[[nodiscard]] inline encode_digit_units_function_* select_digit_units_encoder_(const digit_unit_layout_& layout)
+{
+    return layout.hex_digits != nullptr ? encode_hex_units_.select() : &encode_binary_units_;
+}
+
+// Section: Parallel formatting
+
+// Formats segments on nb_threads threads and passes their texts to consume_text in order, on the calling thread.
+// Texts are kept in a ring of slots: a thread waits for its slot to be consumed before formatting a new segment.
+template <class FormatSegment, class ConsumeText>
+void format_segments_in_parallel_(std::size_t nb_segments, unsigned nb_threads, FormatSegment format_segment,
+                                  ConsumeText consume_text)
+{
+    struct slot
+    {
+        std::string text;
+        // Index + 1 of the segment whose text is ready.
+        std::atomic<std::size_t> ready_segment_end = 0;
+    };
+
+    const std::size_t nb_slots = 2 * std::size_t(nb_threads);
+    std::vector<slot> slots(nb_slots);
+    std::atomic<std::size_t> next_segment = 0;
+    std::atomic<std::size_t> nb_consumed_segments = 0;
+    std::atomic<bool> has_failed = false;
+    std::exception_ptr exception;
+    const auto fail = [&]
+    {
+        if (!has_failed.exchange(true))
+            exception = std::current_exception();
+    };
+
+    const auto format_segments = [&]
+    {
+        for (std::size_t segment; (segment = next_segment.fetch_add(1)) < nb_segments;)
+        {
+            for (std::size_t nb_consumed = nb_consumed_segments.load(); nb_consumed + nb_slots <= segment;
+                 nb_consumed = nb_consumed_segments.load())
+                nb_consumed_segments.wait(nb_consumed);
+            slot& segment_slot = slots[segment % nb_slots];
+            if (!has_failed.load()) [[likely]]
+            {
+                try
+                {
+                    format_segment(segment, segment_slot.text);
+                }
+                catch (...)
+                {
+                    fail();
+                }
+            }
+            segment_slot.ready_segment_end.store(segment + 1);
+            segment_slot.ready_segment_end.notify_one();
+        }
+    };
+
+    std::vector<std::jthread> threads;
+    try
+    {
+        threads.reserve(nb_threads);
+        for (unsigned i = 0; i < nb_threads; ++i)
+            threads.emplace_back(format_segments);
+        for (std::size_t segment = 0; segment < nb_segments; ++segment)
+        {
+            slot& segment_slot = slots[segment % nb_slots];
+            for (std::size_t ready_end = segment_slot.ready_segment_end.load(); ready_end != segment + 1;
+                 ready_end = segment_slot.ready_segment_end.load())
+                segment_slot.ready_segment_end.wait(ready_end);
+            if (has_failed.load()) [[unlikely]]
+                break;
+            consume_text(std::as_const(segment_slot.text));
+            nb_consumed_segments.store(segment + 1);
+            nb_consumed_segments.notify_all();
+        }
+    }
+    catch (...)
+    {
+        fail();
+    }
+    if (has_failed.load()) [[unlikely]]
+    {
+        // Releases the threads waiting for a slot: they skip the remaining segments.
+        nb_consumed_segments.store(nb_segments);
+        nb_consumed_segments.notify_all();
+    }
+    threads.clear();
+    if (exception) [[unlikely]]
+        std::rethrow_exception(exception);
+}
+
+// Section: Read-ahead
+
+// Reads blocks with read_block(std::span<std::byte>) -> std::size_t, which returns 0 at the end of the input, and
+// passes them to consume_block. After a full first block, a thread reads the next block while the current one is
+// consumed.
+// If consume_block throws, no other block is read, but the exception is propagated once the read in flight is done: on
+// a pipe, it waits for more input or for the end of the input.
+template <class ReadBlock, class ConsumeBlock>
+void read_blocks_ahead_(std::size_t block_size, ReadBlock read_block, ConsumeBlock consume_block)
+{
+    std::vector<std::byte> buffers(2 * block_size);
+    const std::array<std::span<std::byte>, 2> blocks = { std::span(buffers).first(block_size),
+                                                         std::span(buffers).last(block_size) };
+    std::array<std::size_t, 2> block_sizes = { read_block(blocks[0]), 0 };
+    if (block_sizes[0] < block_size)
+    {
+        if (block_sizes[0] > 0)
+            consume_block(std::span<const std::byte>(blocks[0].first(block_sizes[0])));
+        return;
+    }
+
+    std::array<std::binary_semaphore, 2> free_blocks = { std::binary_semaphore(0), std::binary_semaphore(1) };
+    std::array<std::binary_semaphore, 2> read_blocks = { std::binary_semaphore(1), std::binary_semaphore(0) };
+    std::atomic<bool> is_stopped = false;
+    std::exception_ptr read_exception;
+    std::jthread reader(
+        [&]
+        {
+            for (std::size_t i = 1;; ++i)
+            {
+                free_blocks[i % 2].acquire();
+                if (is_stopped.load()) [[unlikely]]
+                    return;
+                try
+                {
+                    block_sizes[i % 2] = read_block(blocks[i % 2]);
+                }
+                catch (...)
+                {
+                    read_exception = std::current_exception();
+                    block_sizes[i % 2] = 0;
+                }
+                read_blocks[i % 2].release();
+                if (block_sizes[i % 2] == 0)
+                    return;
+            }
+        });
+
+    std::size_t block_index = 0;
+    try
+    {
+        for (;; ++block_index)
+        {
+            read_blocks[block_index % 2].acquire();
+            if (block_sizes[block_index % 2] == 0)
+                break;
+            consume_block(std::span<const std::byte>(blocks[block_index % 2].first(block_sizes[block_index % 2])));
+            free_blocks[block_index % 2].release();
+        }
+    }
+    catch (...)
+    {
+        // The reader can only wait for the block being consumed, the other one being free or read. Once its current
+        // read is done, it acquires it and stops.
+        is_stopped.store(true);
+        free_blocks[block_index % 2].release();
+        throw;
+    }
+    reader.join();
+    if (read_exception) [[unlikely]]
+        std::rethrow_exception(read_exception);
+}
+
+// Section: File input
+
+#if defined(ARBA_CORE_HAS_POSIX_IO)
+// Read-only memory mapping of a window of a file.
+class mapped_file_window_
+{
+public:
+    mapped_file_window_(const std::filesystem::path& file_path, std::size_t offset, std::size_t length)
+    {
+        fd_ = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) [[unlikely]]
+            throw std::system_error(errno, std::generic_category(), "Failed to open " + file_path.string());
+        try
+        {
+            map_(offset, length);
+        }
+        catch (...)
+        {
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    mapped_file_window_(const mapped_file_window_&) = delete;
+    mapped_file_window_& operator=(const mapped_file_window_&) = delete;
+
+    ~mapped_file_window_()
+    {
+        if (mapping_size_ > 0)
+            ::munmap(mapping_, mapping_size_);
+        ::close(fd_);
+    }
+
+    [[nodiscard]] inline std::span<const std::byte> bytes() const { return bytes_; }
+
+    // Holes of a sparse file in the window, as [begin, end) positions in bytes(), where the file system reports them.
+    // Their bytes are zeros which do not need to be read.
+    [[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>> holes() const
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> holes;
+#if defined(SEEK_HOLE) && defined(SEEK_DATA)
+        const off_t end = static_cast<off_t>(offset_ + bytes_.size());
+        for (off_t pos = static_cast<off_t>(offset_); pos < end;)
+        {
+            const off_t hole = ::lseek(fd_, pos, SEEK_HOLE);
+            if (hole < 0 || hole >= end)
+                break;
+            // No data after the hole (ENXIO): the hole ends with the file.
+            const off_t data = ::lseek(fd_, hole, SEEK_DATA);
+            const off_t hole_end = data < 0 ? end : std::min(data, end);
+            holes.emplace_back(static_cast<std::size_t>(hole) - offset_, static_cast<std::size_t>(hole_end) - offset_);
+            pos = hole_end;
+        }
+#endif
+        return holes;
+    }
+
+private:
+    void map_(std::size_t offset, std::size_t length)
+    {
+        struct stat file_status;
+        if (::fstat(fd_, &file_status) != 0) [[unlikely]]
+            throw std::system_error(errno, std::generic_category(), "Failed to get the size of the file.");
+        const std::size_t file_size = static_cast<std::size_t>(file_status.st_size);
+        if (offset > file_size) [[unlikely]]
+            throw std::out_of_range("Offset is beyond the end of the file.");
+        length = std::min(length, file_size - offset);
+        if (length == 0)
+            return;
+
+        // The mapping starts at a page boundary.
+        offset_ = offset;
+        const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t page_offset = offset % page_size;
+        void* mapping = ::mmap(nullptr, page_offset + length, PROT_READ, MAP_PRIVATE, fd_,
+                               static_cast<off_t>(offset - page_offset));
+        if (mapping == MAP_FAILED) [[unlikely]]
+            throw std::system_error(errno, std::generic_category(), "Failed to map the file.");
+        mapping_ = mapping;
+        mapping_size_ = page_offset + length;
+        ::madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+        bytes_ = std::span(static_cast<const std::byte*>(mapping_) + page_offset, length);
+    }
+
+private:
+    int fd_ = -1;
+    std::size_t offset_ = 0;
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    std::span<const std::byte> bytes_;
+};
+#else
+// Fallback without memory mapping: the window of the file is read in memory.
+class mapped_file_window_
+{
+public:
+    mapped_file_window_(const std::filesystem::path& file_path, std::size_t offset, std::size_t length)
+    {
+        const std::size_t file_size = static_cast<std::size_t>(std::filesystem::file_size(file_path));
+        if (offset > file_size) [[unlikely]]
+            throw std::out_of_range("Offset is beyond the end of the file.");
+        bytes_.resize(std::min(length, file_size - offset));
+        std::ifstream stream(file_path, std::ios::binary);
+        stream.seekg(static_cast<std::streamoff>(offset));
+        if (!stream.read(reinterpret_cast<char*>(bytes_.data()), static_cast<std::streamsize>(bytes_.size())))
+            [[unlikely]]
+            throw std::system_error(std::make_error_code(std::errc::io_error), "Failed to read " + file_path.string());
+    }
+
+    [[nodiscard]] inline std::span<const std::byte> bytes() const { return bytes_; }
+    [[nodiscard]] inline std::vector<std::pair<std::size_t, std::size_t>> holes() const { return {}; }
+
+private:
+    std::vector<std::byte> bytes_;
+};
+#endif
+
+// Section: Output sinks
+
+// A sink exposes the text to append to, and flush() is called after each input block.
+template <class Text>
+class append_text_sink_
+{
+public:
+    explicit append_text_sink_(Text& text) : text_(text) {}
+    [[nodiscard]] inline Text& text() { return text_; }
+    inline void flush() {}
+
+private:
+    Text& text_;
+};
+
+class ostream_text_sink_
+{
+public:
+    explicit ostream_text_sink_(std::ostream& stream) : stream_(stream) {}
+    [[nodiscard]] inline std::string& text() { return text_; }
+    inline void flush()
+    {
+        stream_.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+        text_.clear();
+    }
+
+private:
+    std::ostream& stream_;
+    std::string text_;
+};
+
+class file_text_sink_
+{
+public:
+    explicit file_text_sink_(FILE* file) : file_(file) {}
+    [[nodiscard]] inline std::string& text() { return text_; }
+    inline void flush()
+    {
+        if (std::fwrite(text_.data(), 1, text_.size(), file_) != text_.size()) [[unlikely]]
+            throw std::system_error(errno, std::generic_category(), "Failed to write formatted bytes.");
+        text_.clear();
+    }
+
+private:
+    FILE* file_;
+    std::string text_;
+};
+
+#if defined(ARBA_CORE_HAS_POSIX_IO)
+class fd_text_sink_
+{
+public:
+    explicit fd_text_sink_(int fd) : fd_(fd) {}
+    [[nodiscard]] inline std::string& text() { return text_; }
+    inline void flush()
+    {
+        for (std::string_view text = text_; !text.empty();)
+        {
+            const ssize_t nb_written = ::write(fd_, text.data(), text.size());
+            if (nb_written < 0) [[unlikely]]
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "Failed to write formatted bytes.");
+            }
+            text.remove_prefix(static_cast<std::size_t>(nb_written));
+        }
+        text_.clear();
+    }
+
+private:
+    int fd_;
+    std::string text_;
+};
+#endif
+
+template <class OutputIt>
+class iterator_text_sink_
+{
+public:
+    explicit iterator_text_sink_(OutputIt iter) : iter_(std::move(iter)) {}
+    [[nodiscard]] inline std::string& text() { return text_; }
+    inline void flush()
+    {
+        iter_ = std::ranges::copy(text_, std::move(iter_)).out;
+        text_.clear();
+    }
+    [[nodiscard]] inline OutputIt iterator() && { return std::move(iter_); }
+
+private:
+    OutputIt iter_;
+    std::string text_;
+};
+
+template <class Output>
+inline auto make_text_sink_(Output&& output)
+{
+    using output_type = std::remove_cvref_t<Output>;
+    if constexpr (std::derived_from<output_type, std::ostream>)
+        return ostream_text_sink_(output);
+    else if constexpr (std::same_as<output_type, std::string> || std::same_as<output_type, std::vector<char>>)
+        return append_text_sink_<output_type>(output);
+    else if constexpr (std::same_as<output_type, FILE*>)
+        return file_text_sink_(output);
+#if defined(ARBA_CORE_HAS_POSIX_IO)
+    else if constexpr (std::same_as<output_type, fd_output>)
+        return fd_text_sink_(output.fd);
+#endif
+    else
+        return iterator_text_sink_<output_type>(std::forward<Output>(output));
+}
+
+template <class Sink>
+inline auto text_sink_result_(Sink& sink)
+{
+    if constexpr (requires { std::move(sink).iterator(); })
+        return std::move(sink).iterator();
+}
+} // namespace private_
+
+class bytes_parser;
 
 class bytes_formatter
 {
     static constexpr std::size_t buffer_size = 64 * 1024;
+    // Size of the input segments formatted by each thread, rounded down to whole chunks.
+    static constexpr std::size_t parallel_segment_size = 256 * 1024;
 
 public:
     template <typename... Kwargs>
@@ -47,7 +970,7 @@ public:
     bytes_formatter(Kwargs&&... kwargs)
     {
         meta::kwargs_parser<Kwargs...> k_parser(std::forward<Kwargs>(kwargs)...);
-        unit_format_ = k_parser.template arg_or_default<bytes_formatter_kwargs::unit_format>("{:x}");
+        set_unit_format(k_parser.template arg_or_default<bytes_formatter_kwargs::unit_format>("{:x}"));
         unit_sep_ = k_parser.template arg_or_default<bytes_formatter_kwargs::unit_sep>(", ");
         seq_beginning_ = k_parser.template arg_or_default<bytes_formatter_kwargs::seq_beginning>("[");
         seq_end_ = k_parser.template arg_or_default<bytes_formatter_kwargs::seq_end>("]");
@@ -56,13 +979,24 @@ public:
         nb_units_per_chunk_ = k_parser.template arg_or_default<bytes_formatter_kwargs::nb_units_per_chunk>(32);
         force_chunk_end_ =
             k_parser.template arg_or_default<bytes_formatter_kwargs::force_chunk_end>(!chunk_beginning_.empty());
+        nb_threads_ = k_parser.template arg_or_default<bytes_formatter_kwargs::nb_threads>(1);
+        update_digit_unit_layout_();
     }
 
     [[nodiscard]] inline const std::string& unit_format() const { return unit_format_; }
-    inline void set_unit_format(const std::string& unit_format) { unit_format_ = unit_format; }
+    inline void set_unit_format(const std::string& unit_format)
+    {
+        unit_format_plan_ = private_::unit_format_plan_(unit_format);
+        unit_format_ = unit_format;
+        update_digit_unit_layout_();
+    }
 
     [[nodiscard]] inline const std::string& unit_sep() const { return unit_sep_; }
-    inline void set_unit_sep(const std::string& unit_sep) { unit_sep_ = unit_sep; }
+    inline void set_unit_sep(const std::string& unit_sep)
+    {
+        unit_sep_ = unit_sep;
+        update_digit_unit_layout_();
+    }
 
     [[nodiscard]] inline const std::string& seq_beginning() const { return seq_beginning_; }
     inline void set_seq_beginning(const std::string& seq_beginning) { seq_beginning_ = seq_beginning; }
@@ -82,34 +1016,174 @@ public:
     [[nodiscard]] inline bool force_chunk_end() const { return force_chunk_end_; }
     inline void set_force_chunk_end(bool force_chunk_end) { force_chunk_end_ = force_chunk_end; }
 
+    /**
+     * @brief Number of threads formatting large spans of bytes, 0 meaning one per hardware thread.
+     *
+     * The output is the same whatever the number of threads. Streams are always formatted by the calling thread.
+     */
+    [[nodiscard]] inline uint32_t nb_threads() const { return nb_threads_; }
+    inline void set_nb_threads(uint32_t nb_threads) { nb_threads_ = nb_threads; }
+
 public:
-    void format_binary_stream_to(std::istream& input_stream, std::ostream& output_stream,
-                                 std::size_t first_unit_index = 0) const;
-    void format_binary_cstream_to(FILE* input_stream, std::ostream& output_stream,
-                                  std::size_t first_unit_index = 0) const;
-    void format_bytes_to(std::span<const std::byte> bytes, std::ostream& output_stream,
-                         std::size_t first_unit_index = 0) const;
+    /**
+     * @brief Formatting state of format_bytes_to() writing into successive caller-provided buffers.
+     */
+    class span_output_state
+    {
+    public:
+        explicit span_output_state(std::size_t first_unit_index = 0) : unit_index_(first_unit_index) {}
+
+        [[nodiscard]] inline bool done() const
+        {
+            return stage_ == stage_t::done && pending_pos_ == pending_text_.size();
+        }
+        [[nodiscard]] inline std::size_t nb_formatted_bytes() const { return nb_formatted_bytes_; }
+
+    private:
+        friend class bytes_formatter;
+
+        enum class stage_t : uint8_t
+        {
+            seq_beginning,
+            units,
+            seq_end,
+            done,
+        };
+
+        std::string pending_text_;
+        std::size_t pending_pos_ = 0;
+        std::size_t nb_formatted_bytes_ = 0;
+        std::size_t unit_counter_ = 0;
+        std::size_t unit_index_;
+        stage_t stage_ = stage_t::seq_beginning;
+    };
+
+    /**
+     * @brief Formats a sequence of bytes received in successive pieces, as if they were formatted at once.
+     *
+     * The text of each call is written in a buffer reused by the next calls. The formatter must outlive the session.
+     */
+    class session
+    {
+    public:
+        explicit session(const bytes_formatter& formatter, std::size_t first_unit_index = 0)
+            : formatter_(&formatter), unit_index_(first_unit_index)
+        {
+        }
+
+        /**
+         * @return The text of the units completed by bytes, valid until the next call. The last byte received is
+         * formatted by the next call, which tells whether it is the last unit.
+         * @throw std::logic_error If the session is finished.
+         */
+        [[nodiscard]] std::string_view feed(std::span<const std::byte> bytes);
+        /**
+         * @return The text ending the sequence, valid until the next call.
+         * @throw std::logic_error If the session is already finished.
+         */
+        [[nodiscard]] std::string_view finish();
+        // Starts a new sequence, keeping the buffer.
+        void reset(std::size_t first_unit_index = 0);
+
+        [[nodiscard]] inline bool is_finished() const { return is_finished_; }
+        [[nodiscard]] inline std::size_t nb_received_bytes() const { return nb_received_bytes_; }
+
+    private:
+        void begin_text_();
+
+    private:
+        const bytes_formatter* formatter_;
+        std::string text_;
+        std::size_t nb_received_bytes_ = 0;
+        std::size_t unit_counter_ = 0;
+        std::size_t unit_index_;
+        std::optional<std::byte> pending_byte_;
+        bool has_begun_ = false;
+        bool is_finished_ = false;
+    };
+
+    /**
+     * @return The end output iterator if output is an iterator.
+     */
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_binary_stream_to(std::istream& input_stream, Output&& output, std::size_t first_unit_index = 0) const;
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_binary_cstream_to(FILE* input_stream, Output&& output, std::size_t first_unit_index = 0) const;
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_bytes_to(std::span<const std::byte> bytes, Output&& output, std::size_t first_unit_index = 0) const;
+    /**
+     * @brief Formats the bytes of a file window, read through a memory mapping where available.
+     * @param offset The position of the first byte of the window, which is also the first unit index.
+     * @param length The maximal size of the window, which ends at the end of the file at most.
+     * @throw std::system_error If the file cannot be opened or mapped.
+     * @throw std::out_of_range If offset is beyond the end of the file.
+     */
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_binary_file_to(const std::filesystem::path& file_path, Output&& output, std::size_t offset = 0,
+                               std::size_t length = std::dynamic_extent) const;
+
+    /**
+     * @brief Formats as much of bytes as fits in output.
+     * @param bytes The bytes to format, the same ones for each call with the same state.
+     * @return The number of characters written in output. Formatting is complete when state.done() is true.
+     */
+    [[nodiscard]] std::size_t format_bytes_to(std::span<const std::byte> bytes, std::span<char> output,
+                                              span_output_state& state) const;
 
     [[nodiscard]] std::string format_binary_stream(std::istream& input_stream, std::size_t first_unit_index = 0) const;
     [[nodiscard]] std::string format_binary_cstream(FILE* input_stream, std::size_t first_unit_index = 0) const;
+    [[nodiscard]] std::string format_binary_file(const std::filesystem::path& file_path, std::size_t offset = 0,
+                                                 std::size_t length = std::dynamic_extent) const;
     [[nodiscard]] std::string format_bytes(std::span<const std::byte> bytes, std::size_t first_byte_index = 0) const;
 
 private:
-    [[nodiscard]] inline bool uses_simple_format_() const { return unit_format_ == "{}"; }
-    void format_bytes_to_(std::span<const std::byte> bytes, std::ostream& output_stream, std::size_t& unit_counter,
+    friend class bytes_parser;
+
+    template <class Sink>
+    void format_binary_stream_to_(std::istream& input_stream, Sink& sink, std::size_t unit_index) const;
+    template <class Sink>
+    void format_binary_cstream_to_(FILE* input_stream, Sink& sink, std::size_t unit_index) const;
+    template <class ReadBlock, class Sink>
+    void format_blocks_to_sink_(ReadBlock read_block, Sink& sink, std::size_t unit_index) const;
+    template <class Sink>
+    void format_bytes_to_sink_(std::span<const std::byte> bytes, Sink& sink, std::size_t unit_index) const;
+    template <class Sink>
+    void format_bytes_in_parallel_to_sink_(std::span<const std::byte> bytes, Sink& sink, std::size_t unit_index,
+                                           unsigned nb_threads) const;
+
+    template <class Text>
+    void format_bytes_to_(std::span<const std::byte> bytes, Text& text, std::size_t& unit_counter,
                           std::size_t& unit_index) const;
-    bool format_byte_to_(std::byte byte, std::ostream& output_stream, std::size_t& unit_counter,
-                         std::size_t& unit_index, std::string_view unit_sep, bool use_simple_format) const;
-    inline void format_last_byte_to_(std::byte byte, std::ostream& output_stream, std::size_t& unit_counter,
+    template <class Text>
+    bool format_byte_to_(std::byte byte, Text& text, std::size_t& unit_counter, std::size_t& unit_index,
+                         std::string_view unit_sep) const;
+    template <class Text>
+    inline void format_last_byte_to_(std::byte byte, Text& text, std::size_t& unit_counter,
                                      std::size_t& unit_index) const
     {
-        if (!format_byte_to_(byte, output_stream, unit_counter, unit_index, "", uses_simple_format_())
-            && force_chunk_end_)
-            output_stream << chunk_end_;
+        if (!format_byte_to_(byte, text, unit_counter, unit_index, "") && force_chunk_end_)
+            private_::append_text_(text, chunk_end_);
+    }
+
+    [[nodiscard]] inline unsigned effective_nb_threads_() const
+    {
+        return nb_threads_ != 0 ? nb_threads_ : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    inline void update_digit_unit_layout_()
+    {
+        digit_unit_layout_ = private_::make_digit_unit_layout_(unit_format_plan_.lone_byte_format(), unit_sep_);
     }
 
 private:
     std::string unit_format_;
+    private_::unit_format_plan_ unit_format_plan_;
+    // Set when units are hexadecimal or binary digits only, which are then encoded a whole chunk at once.
+    std::optional<private_::digit_unit_layout_> digit_unit_layout_;
     std::string unit_sep_;
     std::string seq_beginning_;
     std::string seq_end_;
@@ -117,132 +1191,351 @@ private:
     std::string chunk_end_;
     uint32_t nb_units_per_chunk_;
     bool force_chunk_end_;
+    uint32_t nb_threads_;
 };
 
-inline void bytes_formatter::format_binary_stream_to(std::istream& input_stream, std::ostream& output_stream,
-                                                     std::size_t unit_index) const
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto bytes_formatter::format_binary_stream_to(std::istream& input_stream, Output&& output,
+                                                     std::size_t first_unit_index) const
+{
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_binary_stream_to_(input_stream, sink, first_unit_index);
+    return private_::text_sink_result_(sink);
+}
+
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto bytes_formatter::format_binary_cstream_to(FILE* input_stream, Output&& output,
+                                                      std::size_t first_unit_index) const
 {
-    const std::size_t current_pos = input_stream.tellg();
-    input_stream.seekg(0, std::ios::end);
-    std::size_t input_file_size = static_cast<std::size_t>(input_stream.tellg()) - current_pos;
-    input_stream.seekg(current_pos, std::ios::beg);
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_binary_cstream_to_(input_stream, sink, first_unit_index);
+    return private_::text_sink_result_(sink);
+}
 
-    output_stream << seq_beginning_;
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto bytes_formatter::format_bytes_to(std::span<const std::byte> bytes, Output&& output,
+                                             std::size_t first_unit_index) const
+{
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_bytes_to_sink_(bytes, sink, first_unit_index);
+    return private_::text_sink_result_(sink);
+}
 
-    std::size_t nb_full_iterations = input_file_size / buffer_size;
-    std::size_t nb_last_bytes = input_file_size % buffer_size;
-    if (nb_last_bytes == 0 && nb_full_iterations > 0) [[unlikely]]
-    {
-        --nb_full_iterations;
-        nb_last_bytes = buffer_size;
-    }
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto bytes_formatter::format_binary_file_to(const std::filesystem::path& file_path, Output&& output,
+                                                   std::size_t offset, std::size_t length) const
+{
+    const private_::mapped_file_window_ file_window(file_path, offset, length);
+    return format_bytes_to(file_window.bytes(), std::forward<Output>(output), offset);
+}
 
-    std::size_t unit_counter = 0;
-    std::array<std::byte, buffer_size> bytes;
-    for (; nb_full_iterations > 0; --nb_full_iterations)
-    {
-        input_stream.read(reinterpret_cast<char*>(bytes.data()), buffer_size);
-        format_bytes_to_(bytes, output_stream, unit_counter, unit_index);
-    }
+inline std::size_t bytes_formatter::format_bytes_to(std::span<const std::byte> bytes, std::span<char> output,
+                                                    span_output_state& state) const
+{
+    using stage_t = span_output_state::stage_t;
 
-    if (nb_last_bytes > 0) [[likely]]
+    std::size_t nb_written = 0;
+    for (;;)
     {
-        input_stream.read(reinterpret_cast<char*>(bytes.data()), nb_last_bytes);
-        format_bytes_to_(std::span(bytes.data(), nb_last_bytes - 1), output_stream, unit_counter, unit_index);
-        format_last_byte_to_(bytes[nb_last_bytes - 1], output_stream, unit_counter, unit_index);
+        const std::size_t nb_pending = state.pending_text_.size() - state.pending_pos_;
+        const std::size_t nb_copied = std::min(nb_pending, output.size() - nb_written);
+        std::copy_n(state.pending_text_.data() + state.pending_pos_, nb_copied, output.data() + nb_written);
+        state.pending_pos_ += nb_copied;
+        nb_written += nb_copied;
+        if (nb_copied < nb_pending || state.stage_ == stage_t::done)
+            return nb_written;
+
+        std::string& text = state.pending_text_;
+        text.clear();
+        state.pending_pos_ = 0;
+        switch (state.stage_)
+        {
+        case stage_t::seq_beginning:
+            text.append(seq_beginning_);
+            state.stage_ = bytes.empty() ? stage_t::seq_end : stage_t::units;
+            break;
+        case stage_t::units:
+            // Format enough units to fill the remaining output space.
+            do
+            {
+                const std::byte byte = bytes[state.nb_formatted_bytes_++];
+                if (state.nb_formatted_bytes_ < bytes.size()) [[likely]]
+                    format_byte_to_(byte, text, state.unit_counter_, state.unit_index_, unit_sep_);
+                else
+                {
+                    format_last_byte_to_(byte, text, state.unit_counter_, state.unit_index_);
+                    state.stage_ = stage_t::seq_end;
+                }
+            } while (state.stage_ == stage_t::units && text.size() < output.size() - nb_written);
+            break;
+        case stage_t::seq_end:
+            text.append(seq_end_);
+            state.stage_ = stage_t::done;
+            break;
+        case stage_t::done:
+            break;
+        }
     }
+}
+
+inline std::string bytes_formatter::format_binary_stream(std::istream& input_stream, std::size_t first_unit_index) const
+{
+    std::string text;
+    format_binary_stream_to(input_stream, text, first_unit_index);
+    return text;
+}
+
+inline std::string bytes_formatter::format_binary_cstream(FILE* input_stream, std::size_t first_unit_index) const
+{
+    std::string text;
+    format_binary_cstream_to(input_stream, text, first_unit_index);
+    return text;
+}
+
+inline std::string bytes_formatter::format_binary_file(const std::filesystem::path& file_path, std::size_t offset,
+                                                       std::size_t length) const
+{
+    std::string text;
+    format_binary_file_to(file_path, text, offset, length);
+    return text;
+}
 
-    output_stream << seq_end_;
+inline std::string bytes_formatter::format_bytes(std::span<const std::byte> bytes, std::size_t first_byte_index) const
+{
+    std::string text;
+    format_bytes_to(bytes, text, first_byte_index);
+    return text;
 }
 
-inline void bytes_formatter::format_binary_cstream_to(FILE* input_stream, std::ostream& output_stream,
+template <class Sink>
+inline void bytes_formatter::format_binary_stream_to_(std::istream& input_stream, Sink& sink,
                                                       std::size_t unit_index) const
 {
-    output_stream << seq_beginning_;
+    format_blocks_to_sink_(
+        [&input_stream](std::span<std::byte> block)
+        {
+            input_stream.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block.size()));
+            if (input_stream.bad()) [[unlikely]]
+                throw std::ios_base::failure("Failed to read the input stream.");
+            return static_cast<std::size_t>(input_stream.gcount());
+        },
+        sink, unit_index);
+}
 
-    std::size_t unit_counter = 0;
-    std::array<std::byte, buffer_size> bytes;
-    while (!std::feof(input_stream)) [[likely]]
-    {
-        const size_t nb_bytes = std::fread(bytes.data(), 1, buffer_size, input_stream);
-        int ch = std::fgetc(input_stream);
-        ungetc(ch, input_stream);
-        if (ch != EOF)
-            format_bytes_to_(std::span(bytes), output_stream, unit_counter, unit_index);
-        else
+template <class Sink>
+inline void bytes_formatter::format_binary_cstream_to_(FILE* input_stream, Sink& sink, std::size_t unit_index) const
+{
+    format_blocks_to_sink_(
+        [input_stream](std::span<std::byte> block)
         {
-            format_bytes_to_(std::span(bytes.data(), nb_bytes - 1), output_stream, unit_counter, unit_index);
-            format_last_byte_to_(bytes[nb_bytes - 1], output_stream, unit_counter, unit_index);
-            break;
-        }
-    }
+            const std::size_t nb_bytes = std::fread(block.data(), 1, block.size(), input_stream);
+            if (nb_bytes < block.size() && std::ferror(input_stream)) [[unlikely]]
+                throw std::system_error(errno, std::generic_category(), "Failed to read the input stream.");
+            return nb_bytes;
+        },
+        sink, unit_index);
+}
 
-    output_stream << seq_end_;
+// The input size is unknown: the last byte of each block is formatted once the next block is read, to know whether
+// it is the last unit.
+template <class ReadBlock, class Sink>
+inline void bytes_formatter::format_blocks_to_sink_(ReadBlock read_block, Sink& sink, std::size_t unit_index) const
+{
+    private_::append_text_(sink.text(), seq_beginning_);
+    std::size_t unit_counter = 0;
+    std::optional<std::byte> pending_byte;
+    const auto format_block = [&](std::span<const std::byte> block)
+    {
+        if (pending_byte)
+            format_byte_to_(*pending_byte, sink.text(), unit_counter, unit_index, unit_sep_);
+        format_bytes_to_(block.first(block.size() - 1), sink.text(), unit_counter, unit_index);
+        pending_byte = block.back();
+        sink.flush();
+    };
+    private_::read_blocks_ahead_(buffer_size, read_block, format_block);
+    if (pending_byte)
+        format_last_byte_to_(*pending_byte, sink.text(), unit_counter, unit_index);
+    private_::append_text_(sink.text(), seq_end_);
+    sink.flush();
 }
 
-inline void bytes_formatter::format_bytes_to(std::span<const std::byte> bytes, std::ostream& output_stream,
-                                             std::size_t unit_index) const
+template <class Sink>
+inline void bytes_formatter::format_bytes_to_sink_(std::span<const std::byte> bytes, Sink& sink,
+                                                   std::size_t unit_index) const
 {
-    output_stream << seq_beginning_;
+    if (const unsigned nb_threads = effective_nb_threads_(); nb_threads > 1 && bytes.size() > parallel_segment_size)
+        return format_bytes_in_parallel_to_sink_(bytes, sink, unit_index, nb_threads);
+
+    private_::append_text_(sink.text(), seq_beginning_);
     if (bytes.size() > 0) [[likely]]
     {
         std::size_t unit_counter = 0;
-        format_bytes_to_(bytes.subspan(0, bytes.size() - 1), output_stream, unit_counter, unit_index);
-        format_last_byte_to_(bytes.back(), output_stream, unit_counter, unit_index);
+        for (; bytes.size() > buffer_size; bytes = bytes.subspan(buffer_size))
+        {
+            format_bytes_to_(bytes.first(buffer_size), sink.text(), unit_counter, unit_index);
+            sink.flush();
+        }
+        format_bytes_to_(bytes.first(bytes.size() - 1), sink.text(), unit_counter, unit_index);
+        format_last_byte_to_(bytes.back(), sink.text(), unit_counter, unit_index);
     }
-    output_stream << seq_end_;
+    private_::append_text_(sink.text(), seq_end_);
+    sink.flush();
 }
 
-inline std::string bytes_formatter::format_binary_stream(std::istream& input_stream, std::size_t first_unit_index) const
+// Segments start at a chunk beginning, so that each one is formatted from its own unit counter and unit index.
+template <class Sink>
+inline void bytes_formatter::format_bytes_in_parallel_to_sink_(std::span<const std::byte> bytes, Sink& sink,
+                                                               std::size_t unit_index, unsigned nb_threads) const
 {
-    std::ostringstream stream;
-    format_binary_stream_to(input_stream, stream, first_unit_index);
-    return stream.str();
+    const std::size_t segment_size =
+        std::max<std::size_t>(parallel_segment_size / nb_units_per_chunk_, 1) * nb_units_per_chunk_;
+    const std::size_t nb_segments = (bytes.size() + segment_size - 1) / segment_size;
+    private_::append_text_(sink.text(), seq_beginning_);
+    private_::format_segments_in_parallel_(
+        nb_segments, static_cast<unsigned>(std::min<std::size_t>(nb_threads, nb_segments)),
+        [&](std::size_t segment, std::string& text)
+        {
+            const std::span<const std::byte> segment_bytes =
+                bytes.subspan(segment * segment_size, std::min(segment_size, bytes.size() - segment * segment_size));
+            std::size_t unit_counter = 0;
+            std::size_t segment_unit_index = unit_index + segment * segment_size;
+            text.clear();
+            if (segment + 1 < nb_segments)
+                format_bytes_to_(segment_bytes, text, unit_counter, segment_unit_index);
+            else
+            {
+                format_bytes_to_(segment_bytes.first(segment_bytes.size() - 1), text, unit_counter, segment_unit_index);
+                format_last_byte_to_(segment_bytes.back(), text, unit_counter, segment_unit_index);
+            }
+        },
+        [&](const std::string& text)
+        {
+            private_::append_text_(sink.text(), text);
+            sink.flush();
+        });
+    private_::append_text_(sink.text(), seq_end_);
+    sink.flush();
 }
 
-inline std::string bytes_formatter::format_binary_cstream(FILE* input_stream, std::size_t first_unit_index) const
+template <class Text>
+inline void bytes_formatter::format_bytes_to_(std::span<const std::byte> bytes, Text& text, std::size_t& unit_counter,
+                                              std::size_t& unit_index) const
 {
-    std::ostringstream stream;
-    format_binary_cstream_to(input_stream, stream, first_unit_index);
-    return stream.str();
-}
+    if (!digit_unit_layout_)
+    {
+        for (auto& byte : bytes)
+            format_byte_to_(byte, text, unit_counter, unit_index, unit_sep_);
+        return;
+    }
 
-inline std::string bytes_formatter::format_bytes(std::span<const std::byte> bytes, std::size_t first_byte_index) const
-{
-    std::ostringstream stream;
-    format_bytes_to(bytes, stream, first_byte_index);
-    return stream.str();
-}
+    // The text size is computed first so that the text is resized once, with room for the separator written after
+    // the last unit of a chunk before being replaced by the chunk end.
+    const private_::digit_unit_layout_& layout = *digit_unit_layout_;
+    std::size_t text_size = text.size();
+    for (std::size_t nb_units = bytes.size(), counter = unit_counter; nb_units > 0;)
+    {
+        const std::size_t nb_chunk_units = std::min<std::size_t>(nb_units, nb_units_per_chunk_ - counter);
+        text_size += (counter == 0 ? chunk_beginning_.size() : 0) + nb_chunk_units * layout.stride;
+        nb_units -= nb_chunk_units;
+        if (counter += nb_chunk_units; counter == nb_units_per_chunk_)
+        {
+            text_size += chunk_end_.size() - unit_sep_.size();
+            counter = 0;
+        }
+    }
+    const std::size_t output_pos = text.size();
+    text.resize(text_size + unit_sep_.size());
+    char* output = text.data() + output_pos;
 
-inline void bytes_formatter::format_bytes_to_(std::span<const std::byte> bytes, std::ostream& output_stream,
-                                              std::size_t& unit_counter, std::size_t& unit_index) const
-{
-    const bool uses_simple_format = uses_simple_format_();
-    for (auto& byte : bytes)
-        format_byte_to_(byte, output_stream, unit_counter, unit_index, unit_sep_, uses_simple_format);
+    const auto encode_digit_units = private_::select_digit_units_encoder_(layout);
+    while (!bytes.empty())
+    {
+        if (unit_counter == 0) [[unlikely]]
+            output = std::ranges::copy(chunk_beginning_, output).out;
+        const std::size_t nb_units = std::min<std::size_t>(bytes.size(), nb_units_per_chunk_ - unit_counter);
+        encode_digit_units(bytes.data(), nb_units, output, layout);
+        output += nb_units * layout.stride;
+        bytes = bytes.subspan(nb_units);
+        unit_index += nb_units;
+        if (unit_counter += nb_units; unit_counter == nb_units_per_chunk_)
+        {
+            output = std::ranges::copy(chunk_end_, output - unit_sep_.size()).out;
+            unit_counter = 0;
+        }
+    }
+    text.resize(text_size);
 }
 
-inline bool bytes_formatter::format_byte_to_(std::byte byte, std::ostream& output_stream, std::size_t& unit_counter,
-                                             std::size_t& unit_index, std::string_view unit_separator,
-                                             bool use_simple_format) const
+template <class Text>
+inline bool bytes_formatter::format_byte_to_(std::byte byte, Text& text, std::size_t& unit_counter,
+                                             std::size_t& unit_index, std::string_view unit_separator) const
 {
     if (unit_counter == 0) [[unlikely]]
-        output_stream << chunk_beginning_;
-    if (use_simple_format)
-        output_stream << static_cast<uint16_t>(byte);
-    else
-        output_stream << std::vformat(unit_format_, std::make_format_args(byte, unit_index));
+        private_::append_text_(text, chunk_beginning_);
+    unit_format_plan_.append_to(text, byte, unit_index);
     ++unit_index;
     if (++unit_counter %= nb_units_per_chunk_; unit_counter == 0) [[unlikely]]
     {
-        output_stream << chunk_end_;
+        private_::append_text_(text, chunk_end_);
         return true;
     }
     else
-        output_stream << unit_separator;
+        private_::append_text_(text, unit_separator);
     return false;
 }
 
+inline std::string_view bytes_formatter::session::feed(std::span<const std::byte> bytes)
+{
+    begin_text_();
+    if (!bytes.empty()) [[likely]]
+    {
+        if (pending_byte_)
+            formatter_->format_byte_to_(*pending_byte_, text_, unit_counter_, unit_index_, formatter_->unit_sep_);
+        formatter_->format_bytes_to_(bytes.first(bytes.size() - 1), text_, unit_counter_, unit_index_);
+        pending_byte_ = bytes.back();
+        nb_received_bytes_ += bytes.size();
+    }
+    return text_;
+}
+
+inline std::string_view bytes_formatter::session::finish()
+{
+    begin_text_();
+    if (pending_byte_)
+        formatter_->format_last_byte_to_(*pending_byte_, text_, unit_counter_, unit_index_);
+    pending_byte_.reset();
+    text_.append(formatter_->seq_end_);
+    is_finished_ = true;
+    return text_;
+}
+
+inline void bytes_formatter::session::reset(std::size_t first_unit_index)
+{
+    text_.clear();
+    nb_received_bytes_ = 0;
+    unit_counter_ = 0;
+    unit_index_ = first_unit_index;
+    pending_byte_.reset();
+    has_begun_ = false;
+    is_finished_ = false;
+}
+
+inline void bytes_formatter::session::begin_text_()
+{
+    if (is_finished_) [[unlikely]]
+        throw std::logic_error("The session is finished.");
+    text_.clear();
+    if (!has_begun_)
+    {
+        text_.append(formatter_->seq_beginning_);
+        has_begun_ = true;
+    }
+}
+
 template <typename... Kwargs>
     requires(BytesFormatterKwarg<Kwargs> && ...)
 [[nodiscard]] inline std::string format_bytes(std::span<const std::byte> bytes, Kwargs&&... kwargs)
@@ -0,0 +1,541 @@
+#pragma once
+
+#include "bytes_formatter.hpp"
+
+#include <arba/core/simd/simd_dispatcher.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief Error raised when a text is not a sequence of bytes formatted as expected by a bytes_parser.
+ */
+class bytes_parse_error : public std::runtime_error
+{
+public:
+    bytes_parse_error(const std::string& message, std::size_t position)
+        : std::runtime_error(message + " (at character " + std::to_string(position) + ")"), position_(position)
+    {
+    }
+
+    // Position in the text of the first character which could not be parsed.
+    [[nodiscard]] inline std::size_t position() const { return position_; }
+
+private:
+    std::size_t position_;
+};
+
+namespace private_
+{
+// Section: Hexadecimal units
+
+consteval std::array<uint8_t, 256> make_hex_digit_values_(std::string_view hex_digits)
+{
+    std::array<uint8_t, 256> values;
+    values.fill(0xff);
+    for (std::size_t i = 0; i < hex_digits.size(); ++i)
+        values[static_cast<uint8_t>(hex_digits[i])] = static_cast<uint8_t>(i);
+    return values;
+}
+
+inline constexpr std::array<uint8_t, 256> hex_digit_values_ = make_hex_digit_values_("0123456789abcdef");
+inline constexpr std::array<uint8_t, 256> upper_hex_digit_values_ = make_hex_digit_values_("0123456789ABCDEF");
+
+// Layout of hexadecimal units to decode, with the shuffles gathering the digits of 16 units from the registers of
+// their text: digits of units 0-7 and 8-15.
+struct hex_unit_decoding_
+{
+    digit_unit_layout_ layout;
+    const std::array<uint8_t, 256>* digit_values = &hex_digit_values_;
+    char first_letter = 'a';
+    std::array<std::array<uint8_t, 16>, digit_unit_layout_::max_simd_stride> low_units_gathers{};
+    std::array<std::array<uint8_t, 16>, digit_unit_layout_::max_simd_stride> high_units_gathers{};
+    // 0xff at the positions of digits, where constant chars are not checked.
+    std::array<std::array<uint8_t, 16>, digit_unit_layout_::max_simd_stride> digit_masks{};
+};
+
+inline std::optional<hex_unit_decoding_> make_hex_unit_decoding_(const std::optional<digit_unit_layout_>& layout)
+{
+    if (!layout || layout->hex_digits == nullptr)
+        return std::nullopt;
+    hex_unit_decoding_ decoding{ .layout = *layout };
+    if (layout->hex_digits[10] == 'A')
+    {
+        decoding.digit_values = &upper_hex_digit_values_;
+        decoding.first_letter = 'A';
+    }
+    if (layout->stride > digit_unit_layout_::max_simd_stride)
+        return decoding;
+
+    for (std::size_t r = 0; r < layout->stride; ++r)
+    {
+        decoding.low_units_gathers[r].fill(0x80);
+        decoding.high_units_gathers[r].fill(0x80);
+        for (std::size_t k = 0; k < 16; ++k)
+            if ((16 * r + k) % layout->stride - layout->digits_pos < 2)
+                decoding.digit_masks[r][k] = 0xff;
+    }
+    for (std::size_t digit_pos = 0; digit_pos < 32; ++digit_pos)
+    {
+        const std::size_t char_pos = digit_pos / 2 * layout->stride + layout->digits_pos + digit_pos % 2;
+        auto& gathers = digit_pos < 16 ? decoding.low_units_gathers : decoding.high_units_gathers;
+        gathers[char_pos / 16][digit_pos % 16] = static_cast<uint8_t>(char_pos % 16);
+    }
+    return decoding;
+}
+
+// Decodes units followed by their separator, and stops at the first one which is not.
+// @return The number of decoded units.
+inline std::size_t decode_hex_units_scalar_(const char* text, std::size_t nb_units, std::byte* output,
+                                            const hex_unit_decoding_& decoding)
+{
+    const digit_unit_layout_& layout = decoding.layout;
+    const std::size_t sep_pos = layout.digits_pos + 2;
+    for (std::size_t i = 0; i < nb_units; ++i, text += layout.stride)
+    {
+        const uint8_t high_digit = (*decoding.digit_values)[static_cast<uint8_t>(text[layout.digits_pos])];
+        const uint8_t low_digit = (*decoding.digit_values)[static_cast<uint8_t>(text[layout.digits_pos + 1])];
+        if ((high_digit | low_digit) > 0x0f || std::memcmp(text, layout.pattern.data(), layout.digits_pos) != 0
+            || std::memcmp(text + sep_pos, layout.pattern.data() + sep_pos, layout.stride - sep_pos) != 0)
+            return i;
+        output[i] = std::byte((high_digit << 4) | low_digit);
+    }
+    return nb_units;
+}
+
+// Decodes a unit not followed by its separator, at the end of a chunk or of the sequence.
+// @return The size of the unit text, or std::string_view::npos.
+inline std::size_t decode_hex_unit_(std::string_view text, std::byte& byte, const hex_unit_decoding_& decoding)
+{
+    const digit_unit_layout_& layout = decoding.layout;
+    if (text.size() < layout.digits_pos + 2u
+        || std::memcmp(text.data(), layout.pattern.data(), layout.digits_pos) != 0)
+        return std::string_view::npos;
+    const uint8_t high_digit = (*decoding.digit_values)[static_cast<uint8_t>(text[layout.digits_pos])];
+    const uint8_t low_digit = (*decoding.digit_values)[static_cast<uint8_t>(text[layout.digits_pos + 1])];
+    if ((high_digit | low_digit) > 0x0f)
+        return std::string_view::npos;
+    byte = std::byte((high_digit << 4) | low_digit);
+    return layout.digits_pos + 2u;
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+// Values of hexadecimal digit chars, and clears valid where a char is not a digit.
+ARBA_CORE_TARGET("ssse3")
+inline __m128i hex_digit_values_ssse3_(__m128i chars, __m128i first_letter, __m128i& valid)
+{
+    const __m128i decimal_values = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_decimal = _mm_cmpeq_epi8(_mm_min_epu8(decimal_values, _mm_set1_epi8(9)), decimal_values);
+    const __m128i letter_values = _mm_sub_epi8(chars, first_letter);
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter_values, _mm_set1_epi8(5)), letter_values);
+    valid = _mm_and_si128(valid, _mm_or_si128(is_decimal, is_letter));
+    return _mm_or_si128(_mm_and_si128(is_decimal, decimal_values),
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter_values, _mm_set1_epi8(10))));
+}
+
+// The digits of 16 units are gathered with shuffles while the constant chars are compared, then pairs of digit values
+// are combined into bytes with a multiply-add.
+// @return false, without writing output, if a unit is not followed by its separator.
+ARBA_CORE_TARGET("ssse3")
+inline bool decode_16_hex_units_ssse3_(const char* text, std::byte* output, const hex_unit_decoding_& decoding)
+{
+    const digit_unit_layout_& layout = decoding.layout;
+    __m128i valid = _mm_set1_epi8(-1);
+    __m128i low_units_digits = _mm_setzero_si128();
+    __m128i high_units_digits = _mm_setzero_si128();
+    for (std::size_t r = 0; r < layout.stride; ++r)
+    {
+        const auto load = [r](const auto& registers)
+        { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(registers[r].data())); };
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16 * r));
+        const __m128i is_constant = _mm_cmpeq_epi8(chars, load(layout.constant_chars));
+        valid = _mm_and_si128(valid, _mm_or_si128(is_constant, load(decoding.digit_masks)));
+        low_units_digits = _mm_or_si128(low_units_digits, _mm_shuffle_epi8(chars, load(decoding.low_units_gathers)));
+        high_units_digits =
+            _mm_or_si128(high_units_digits, _mm_shuffle_epi8(chars, load(decoding.high_units_gathers)));
+    }
+    const __m128i first_letter = _mm_set1_epi8(decoding.first_letter);
+    const __m128i low_units_values = hex_digit_values_ssse3_(low_units_digits, first_letter, valid);
+    const __m128i high_units_values = hex_digit_values_ssse3_(high_units_digits, first_letter, valid);
+    if (_mm_movemask_epi8(valid) != 0xffff) [[unlikely]]
+        return false;
+    const __m128i digit_weights = _mm_set1_epi16(0x0110);
+    const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(low_units_values, digit_weights),
+                                           _mm_maddubs_epi16(high_units_values, digit_weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), bytes);
+    return true;
+}
+
+// The last units are decoded with the block ending with them, which overlaps units already decoded.
+ARBA_CORE_TARGET("ssse3")
+inline std::size_t decode_hex_units_ssse3_(const char* text, std::size_t nb_units, std::byte* output,
+                                           const hex_unit_decoding_& decoding)
+{
+    const std::size_t stride = decoding.layout.stride;
+    if (stride > digit_unit_layout_::max_simd_stride)
+        return decode_hex_units_scalar_(text, nb_units, output, decoding);
+    std::size_t i = 0;
+    for (; nb_units - i >= 16; i += 16)
+        if (!decode_16_hex_units_ssse3_(text + i * stride, output + i, decoding)) [[unlikely]]
+            return i + decode_hex_units_scalar_(text + i * stride, nb_units - i, output + i, decoding);
+    if (i < nb_units && nb_units >= 16
+        && decode_16_hex_units_ssse3_(text + (nb_units - 16) * stride, output + nb_units - 16, decoding))
+        return nb_units;
+    return i + decode_hex_units_scalar_(text + i * stride, nb_units - i, output + i, decoding);
+}
+
+ARBA_CORE_TARGET("avx2")
+inline __m256i broadcast_avx2_(const void* chars)
+{
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(static_cast<const __m128i*>(chars)));
+}
+
+ARBA_CORE_TARGET("avx2")
+inline __m256i hex_digit_values_avx2_(__m256i chars, __m256i first_letter, __m256i& valid)
+{
+    const __m256i decimal_values = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i is_decimal =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(decimal_values, _mm256_set1_epi8(9)), decimal_values);
+    const __m256i letter_values = _mm256_sub_epi8(chars, first_letter);
+    const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter_values, _mm256_set1_epi8(5)), letter_values);
+    valid = _mm256_and_si256(valid, _mm256_or_si256(is_decimal, is_letter));
+    return _mm256_or_si256(_mm256_and_si256(is_decimal, decimal_values),
+                           _mm256_and_si256(is_letter, _mm256_add_epi8(letter_values, _mm256_set1_epi8(10))));
+}
+
+// Same as SSSE3 on 32 units: the 128-bit lanes hold units 0-15 and 16-31, which are decoded in parallel.
+ARBA_CORE_TARGET("avx2")
+inline bool decode_32_hex_units_avx2_(const char* text, std::byte* output, const hex_unit_decoding_& decoding)
+{
+    const digit_unit_layout_& layout = decoding.layout;
+    const std::size_t lane_size = 16 * layout.stride;
+    __m256i valid = _mm256_set1_epi8(-1);
+    __m256i low_units_digits = _mm256_setzero_si256();
+    __m256i high_units_digits = _mm256_setzero_si256();
+    for (std::size_t r = 0; r < layout.stride; ++r)
+    {
+        const __m256i chars = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16 * r))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + lane_size + 16 * r)), 1);
+        const __m256i is_constant = _mm256_cmpeq_epi8(chars, broadcast_avx2_(layout.constant_chars[r].data()));
+        valid = _mm256_and_si256(valid, _mm256_or_si256(is_constant, broadcast_avx2_(decoding.digit_masks[r].data())));
+        low_units_digits = _mm256_or_si256(
+            low_units_digits, _mm256_shuffle_epi8(chars, broadcast_avx2_(decoding.low_units_gathers[r].data())));
+        high_units_digits = _mm256_or_si256(
+            high_units_digits, _mm256_shuffle_epi8(chars, broadcast_avx2_(decoding.high_units_gathers[r].data())));
+    }
+    const __m256i first_letter = _mm256_set1_epi8(decoding.first_letter);
+    const __m256i low_units_values = hex_digit_values_avx2_(low_units_digits, first_letter, valid);
+    const __m256i high_units_values = hex_digit_values_avx2_(high_units_digits, first_letter, valid);
+    if (_mm256_movemask_epi8(valid) != -1) [[unlikely]]
+        return false;
+    const __m256i digit_weights = _mm256_set1_epi16(0x0110);
+    const __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(low_units_values, digit_weights),
+                                              _mm256_maddubs_epi16(high_units_values, digit_weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), bytes);
+    return true;
+}
+
+ARBA_CORE_TARGET("avx2")
+inline std::size_t decode_hex_units_avx2_(const char* text, std::size_t nb_units, std::byte* output,
+                                          const hex_unit_decoding_& decoding)
+{
+    const std::size_t stride = decoding.layout.stride;
+    if (stride > digit_unit_layout_::max_simd_stride)
+        return decode_hex_units_scalar_(text, nb_units, output, decoding);
+    std::size_t i = 0;
+    for (; nb_units - i >= 32; i += 32)
+        if (!decode_32_hex_units_avx2_(text + i * stride, output + i, decoding)) [[unlikely]]
+            return i + decode_hex_units_ssse3_(text + i * stride, nb_units - i, output + i, decoding);
+    if (i < nb_units && nb_units >= 32
+        && decode_32_hex_units_avx2_(text + (nb_units - 32) * stride, output + nb_units - 32, decoding))
+        return nb_units;
+    return i + decode_hex_units_ssse3_(text + i * stride, nb_units - i, output + i, decoding);
+}
+#endif
+
+inline constexpr auto decode_hex_units_ = simd_dispatcher(&decode_hex_units_scalar_)
+#if defined(ARBA_CORE_SIMD_X86)
+                                              .with(simd_level::ssse3, &decode_hex_units_ssse3_)
+                                              .with(simd_level::avx2, &decode_hex_units_avx2_)
+#endif
+    ;
+} // namespace private_
+
+/**
+ * @brief Parser of the texts written by a bytes_formatter with the same settings, giving back the formatted bytes.
+ *
+ * Unit index fields are checked against the expected unit indexes. Hexadecimal units are decoded with SIMD
+ * instructions when available.
+ */
+class bytes_parser
+{
+    static constexpr std::size_t stream_block_size = 1024 * 1024;
+
+public:
+    /**
+     * @brief Parser of the texts formatted by bytes_formatter(kwargs...).
+     * @throw std::invalid_argument If the unit format has no byte field.
+     */
+    template <typename... Kwargs>
+        requires(BytesFormatterKwarg<Kwargs> && ...)
+    explicit bytes_parser(Kwargs&&... kwargs) : bytes_parser(bytes_formatter(std::forward<Kwargs>(kwargs)...))
+    {
+    }
+    /**
+     * @brief Parser of the texts formatted by formatter.
+     * @throw std::invalid_argument If the unit format has no byte field.
+     */
+    explicit bytes_parser(const bytes_formatter& formatter);
+
+    [[nodiscard]] inline const bytes_formatter& formatter() const { return formatter_; }
+
+    /**
+     * @brief Parses text and appends its bytes to output.
+     * @throw bytes_parse_error If text is not a formatted sequence of bytes.
+     */
+    void parse_to(std::string_view text, std::vector<std::byte>& output, std::size_t first_unit_index = 0) const;
+    /**
+     * @throw bytes_parse_error If text is not a formatted sequence of bytes.
+     */
+    [[nodiscard]] std::vector<std::byte> parse(std::string_view text, std::size_t first_unit_index = 0) const;
+    /**
+     * @brief Parses the text of input_stream by blocks, and writes its bytes to output_stream as they are parsed.
+     * @throw bytes_parse_error If the text is not a formatted sequence of bytes. Bytes parsed before the error may
+     * have been written.
+     * @throw std::ios_base::failure If input_stream cannot be read.
+     */
+    void parse_stream_to(std::istream& input_stream, std::ostream& output_stream,
+                         std::size_t first_unit_index = 0) const;
+
+private:
+    struct parse_state_
+    {
+        enum class stage_t : uint8_t
+        {
+            seq_beginning,
+            chunk_beginning,
+            unit_end,
+            done,
+        };
+
+        // Position of the text being parsed in the whole text.
+        std::size_t position = 0;
+        std::size_t unit_counter = 0;
+        std::size_t unit_index;
+        stage_t stage = stage_t::seq_beginning;
+    };
+
+    // Parses text from the state. Unless is_final, parsing stops before the last margin_ characters of text, which
+    // may be the beginning of an element ending in the next text.
+    // @return The number of parsed characters.
+    std::size_t parse_(std::string_view text, parse_state_& state, bool is_final, std::vector<std::byte>& output) const;
+    void parse_units_(std::string_view text, std::size_t& pos, parse_state_& state,
+                      std::vector<std::byte>& output) const;
+
+private:
+    bytes_formatter formatter_;
+    // Set when units are hexadecimal digits only, which are then decoded many at once.
+    std::optional<private_::hex_unit_decoding_> hex_unit_decoding_;
+    // Twice the maximal size of the elements of a text: units, separators, chunk and sequence bounds.
+    std::size_t margin_ = 0;
+};
+
+inline bytes_parser::bytes_parser(const bytes_formatter& formatter)
+    : formatter_(formatter), hex_unit_decoding_(private_::make_hex_unit_decoding_(formatter.digit_unit_layout_))
+{
+    if (!formatter_.unit_format_plan_.has_byte_field()) [[unlikely]]
+        throw std::invalid_argument("The unit format has no byte field.");
+    std::size_t max_unit_size = 0;
+    std::string unit_text;
+    for (unsigned value = 0; value < 256; ++value)
+    {
+        unit_text.clear();
+        formatter_.unit_format_plan_.append_to(unit_text, std::byte(value), std::size_t(-1));
+        max_unit_size = std::max(max_unit_size, unit_text.size());
+    }
+    margin_ = 2
+              * (max_unit_size + formatter_.unit_sep_.size() + formatter_.seq_beginning_.size()
+                 + formatter_.seq_end_.size() + formatter_.chunk_beginning_.size() + formatter_.chunk_end_.size())
+              + 64;
+}
+
+inline void bytes_parser::parse_to(std::string_view text, std::vector<std::byte>& output,
+                                   std::size_t first_unit_index) const
+{
+    parse_state_ state{ .unit_index = first_unit_index };
+    std::ignore = parse_(text, state, true, output);
+}
+
+inline std::vector<std::byte> bytes_parser::parse(std::string_view text, std::size_t first_unit_index) const
+{
+    std::vector<std::byte> bytes;
+    parse_to(text, bytes, first_unit_index);
+    return bytes;
+}
+
+// Blocks are read ahead while the text read so far is parsed. The characters left unparsed at the end of a block are
+// parsed with the next one.
+inline void bytes_parser::parse_stream_to(std::istream& input_stream, std::ostream& output_stream,
+                                          std::size_t first_unit_index) const
+{
+    parse_state_ state{ .unit_index = first_unit_index };
+    std::string text;
+    std::vector<std::byte> bytes;
+    const auto parse_text = [&](bool is_final)
+    {
+        bytes.clear();
+        const std::size_t nb_parsed_chars = parse_(text, state, is_final, bytes);
+        text.erase(0, nb_parsed_chars);
+        output_stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    };
+    private_::read_blocks_ahead_(
+        stream_block_size,
+        [&input_stream](std::span<std::byte> block)
+        {
+            input_stream.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block.size()));
+            if (input_stream.bad()) [[unlikely]]
+                throw std::ios_base::failure("Failed to read the input stream.");
+            return static_cast<std::size_t>(input_stream.gcount());
+        },
+        [&](std::span<const std::byte> block)
+        {
+            text.append(reinterpret_cast<const char*>(block.data()), block.size());
+            parse_text(false);
+        });
+    parse_text(true);
+}
+
+inline std::size_t bytes_parser::parse_(std::string_view text, parse_state_& state, bool is_final,
+                                        std::vector<std::byte>& output) const
+{
+    using stage_t = parse_state_::stage_t;
+    std::size_t pos = 0;
+    const auto expect = [&](std::string_view element, const char* error_message)
+    {
+        if (!text.substr(pos).starts_with(element)) [[unlikely]]
+            throw bytes_parse_error(error_message, state.position + pos);
+        pos += element.size();
+    };
+    const auto ends_with_seq_end = [&](std::string_view chunk_end)
+    {
+        const std::string_view rest = text.substr(pos);
+        return rest.size() == chunk_end.size() + formatter_.seq_end_.size() && rest.starts_with(chunk_end)
+               && rest.ends_with(formatter_.seq_end_);
+    };
+
+    while (state.stage != stage_t::done && (is_final || text.size() - pos >= margin_))
+    {
+        switch (state.stage)
+        {
+        case stage_t::seq_beginning:
+            expect(formatter_.seq_beginning_, "Sequence beginning expected.");
+            state.stage = stage_t::chunk_beginning;
+            break;
+        case stage_t::chunk_beginning:
+            if (is_final && ends_with_seq_end(""))
+            {
+                pos = text.size();
+                state.stage = stage_t::done;
+                break;
+            }
+            expect(formatter_.chunk_beginning_, "Chunk beginning expected.");
+            parse_units_(text, pos, state, output);
+            break;
+        case stage_t::unit_end:
+            if (state.unit_counter == formatter_.nb_units_per_chunk_)
+            {
+                expect(formatter_.chunk_end_, "Chunk end expected.");
+                state.unit_counter = 0;
+                state.stage = stage_t::chunk_beginning;
+            }
+            else if (is_final && ends_with_seq_end(formatter_.force_chunk_end_ ? formatter_.chunk_end_ : ""))
+            {
+                pos = text.size();
+                state.stage = stage_t::done;
+            }
+            else
+            {
+                expect(formatter_.unit_sep_, "Unit separator or sequence end expected.");
+                parse_units_(text, pos, state, output);
+            }
+            break;
+        case stage_t::done:
+            break;
+        }
+    }
+    if (is_final && pos != text.size()) [[unlikely]]
+        throw bytes_parse_error("Unexpected text after the sequence end.", state.position + pos);
+    state.position += pos;
+    return pos;
+}
+
+// Parses the units of the current chunk followed by a separator many at once if they are hexadecimal, then the next
+// unit, whose end is parsed by the caller.
+inline void bytes_parser::parse_units_(std::string_view text, std::size_t& pos, parse_state_& state,
+                                       std::vector<std::byte>& output) const
+{
+    if (hex_unit_decoding_ && text.size() - pos > margin_)
+    {
+        const std::size_t stride = hex_unit_decoding_->layout.stride;
+        const std::size_t max_nb_units = std::min(formatter_.nb_units_per_chunk_ - state.unit_counter - 1,
+                                                  (text.size() - pos - margin_) / stride);
+        const std::size_t output_size = output.size();
+        output.resize(output_size + max_nb_units);
+        const std::size_t nb_units = private_::decode_hex_units_.select()(text.data() + pos, max_nb_units,
+                                                                          output.data() + output_size,
+                                                                          *hex_unit_decoding_);
+        output.resize(output_size + nb_units);
+        pos += nb_units * stride;
+        state.unit_counter += nb_units;
+        state.unit_index += nb_units;
+    }
+
+    std::byte byte{};
+    const std::size_t unit_size =
+        hex_unit_decoding_ ? private_::decode_hex_unit_(text.substr(pos), byte, *hex_unit_decoding_)
+                           : formatter_.unit_format_plan_.match(text.substr(pos), state.unit_index, byte);
+    if (unit_size == std::string_view::npos) [[unlikely]]
+        throw bytes_parse_error("Unit expected.", state.position + pos);
+    output.push_back(byte);
+    pos += unit_size;
+    ++state.unit_counter;
+    ++state.unit_index;
+    state.stage = parse_state_::stage_t::unit_end;
+}
+
+template <typename... Kwargs>
+    requires(BytesFormatterKwarg<Kwargs> && ...)
+[[nodiscard]] inline std::vector<std::byte> parse_bytes(std::string_view text, Kwargs&&... kwargs)
+{
+    const bytes_parser parser(std::forward<Kwargs>(kwargs)...);
+    return parser.parse(text);
+}
+
+template <typename... Kwargs>
+    requires(BytesFormatterKwarg<Kwargs> && ...)
+[[nodiscard]] inline std::vector<std::byte> parse_bytes(std::string_view text, std::size_t first_unit_index,
+                                                        Kwargs&&... kwargs)
+{
+    const bytes_parser parser(std::forward<Kwargs>(kwargs)...);
+    return parser.parse(text, first_unit_index);
+}
+
+} // namespace core
+} // namespace arba
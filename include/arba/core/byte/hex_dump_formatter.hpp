@@ -0,0 +1,606 @@
+#pragma once
+
+#include "bytes_formatter.hpp"
+
+#include <arba/core/simd/simd_dispatcher.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief Classic hex dump layouts, each line starting with the offset of its first byte.
+ */
+enum class hex_dump_layout : uint8_t
+{
+    // As xxd: "00000010: 6300 01ff 7879 7a                        c...xyz".
+    xxd,
+    // As hexdump -C: "00000010  63 00 01 ff 78 79 7a                              |c...xyz|", then the end offset.
+    hexdump_canonical,
+    // As od -x on a little-endian host: "0000020 0063 ff01 7978 007a", with octal offsets, then the end offset.
+    od_hex,
+};
+
+namespace private_
+{
+consteval std::array<char, 256> make_printable_chars_()
+{
+    std::array<char, 256> chars;
+    for (unsigned value = 0; value < 256; ++value)
+        chars[value] = value >= 0x20 && value < 0x7f ? static_cast<char>(value) : '.';
+    return chars;
+}
+
+// Chars of the ASCII gutter: the byte itself if it is printable, '.' otherwise.
+inline constexpr std::array<char, 256> printable_chars_ = make_printable_chars_();
+
+// Writes value in base 2^digit_bits with at least min_nb_digits digits.
+// @return The end of the written digits.
+inline char* write_offset_(char* output, std::size_t value, unsigned digit_bits, unsigned min_nb_digits)
+{
+    const unsigned nb_digits =
+        std::max<unsigned>(min_nb_digits, (static_cast<unsigned>(std::bit_width(value)) + digit_bits - 1) / digit_bits);
+    const std::size_t digit_mask = (std::size_t(1) << digit_bits) - 1;
+    for (unsigned i = nb_digits; i > 0; --i, value >>= digit_bits)
+        output[i - 1] = "0123456789abcdef"[value & digit_mask];
+    return output + nb_digits;
+}
+
+inline char* write_hex_byte_(char* output, std::byte byte)
+{
+    std::memcpy(output, byte_texts_x_[static_cast<uint8_t>(byte)].chars.data(), 2);
+    return output + 2;
+}
+
+// Section: Duplicate lines
+
+// @return The position of the first byte differing between lhs and rhs, or size if they are equal.
+inline std::size_t find_mismatch_scalar_(const std::byte* lhs, const std::byte* rhs, std::size_t size)
+{
+    std::size_t i = 0;
+    for (; size - i >= 8; i += 8)
+    {
+        uint64_t lhs_word, rhs_word;
+        std::memcpy(&lhs_word, lhs + i, 8);
+        std::memcpy(&rhs_word, rhs + i, 8);
+        if (const uint64_t diff = lhs_word ^ rhs_word; diff != 0)
+            return i + static_cast<std::size_t>(std::endian::native == std::endian::little ? std::countr_zero(diff)
+                                                                                            : std::countl_zero(diff))
+                           / 8;
+    }
+    while (i < size && lhs[i] == rhs[i])
+        ++i;
+    return i;
+}
+
+#if defined(ARBA_CORE_SIMD_X86)
+ARBA_CORE_TARGET("sse2")
+inline std::size_t find_mismatch_sse2_(const std::byte* lhs, const std::byte* rhs, std::size_t size)
+{
+    std::size_t i = 0;
+    for (; size - i >= 16; i += 16)
+    {
+        const __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)),
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i)));
+        if (const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(equal)); mask != 0xffff)
+            return i + static_cast<std::size_t>(std::countr_one(mask));
+    }
+    return i + find_mismatch_scalar_(lhs + i, rhs + i, size - i);
+}
+
+// Two registers are compared per iteration, which suits long runs of identical lines.
+ARBA_CORE_TARGET("avx2")
+inline std::size_t find_mismatch_avx2_(const std::byte* lhs, const std::byte* rhs, std::size_t size)
+{
+    std::size_t i = 0;
+    for (; size - i >= 64; i += 64)
+    {
+        const __m256i low_equal = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)),
+                                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)));
+        const __m256i high_equal =
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i + 32)),
+                              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i + 32)));
+        if (_mm256_movemask_epi8(_mm256_and_si256(low_equal, high_equal)) != -1)
+        {
+            const uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(low_equal))
+                                  | uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(high_equal))) << 32;
+            return i + static_cast<std::size_t>(std::countr_one(mask));
+        }
+    }
+    return i + find_mismatch_sse2_(lhs + i, rhs + i, size - i);
+}
+#endif
+
+inline constexpr auto find_mismatch_ = simd_dispatcher(&find_mismatch_scalar_)
+#if defined(ARBA_CORE_SIMD_X86)
+                                           .with(simd_level::sse2, &find_mismatch_sse2_)
+                                           .with(simd_level::avx2, &find_mismatch_avx2_)
+#endif
+    ;
+} // namespace private_
+
+/**
+ * @brief Formatter of bytes in the xxd, hexdump -C or od -x layout.
+ *
+ * Each line is written at once from precomputed digit and char tables, without going through a unit format.
+ */
+class hex_dump_formatter
+{
+    // Size of the blocks of bytes formatted before flushing the text, rounded down to whole lines.
+    static constexpr std::size_t buffer_size = 64 * 1024;
+
+public:
+    static constexpr uint32_t max_nb_bytes_per_line = 256;
+
+    /**
+     * @throw std::invalid_argument If nb_bytes_per_line is odd, 0 or greater than max_nb_bytes_per_line.
+     */
+    explicit hex_dump_formatter(hex_dump_layout layout = hex_dump_layout::xxd, uint32_t nb_bytes_per_line = 16);
+
+    [[nodiscard]] inline hex_dump_layout layout() const { return layout_; }
+    [[nodiscard]] inline uint32_t nb_bytes_per_line() const { return nb_bytes_per_line_; }
+
+    /**
+     * @brief Whether each run of lines identical to the line before them is replaced by a single "*" line, as
+     * hexdump and od do. With the xxd layout, only runs of zero lines are collapsed, and the last line of the input is
+     * written even if it is a duplicate, as xxd -a does.
+     *
+     * The holes of sparse files are then skipped without being read, where the file system reports them.
+     */
+    [[nodiscard]] inline bool collapse_duplicate_lines() const { return collapse_duplicate_lines_; }
+    inline void set_collapse_duplicate_lines(bool collapse_duplicate_lines)
+    {
+        collapse_duplicate_lines_ = collapse_duplicate_lines;
+    }
+
+    /**
+     * @param first_offset The offset of the first byte, written at the beginning of the first line.
+     * @return The end output iterator if output is an iterator.
+     */
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_bytes_to(std::span<const std::byte> bytes, Output&& output, std::size_t first_offset = 0) const;
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_binary_stream_to(std::istream& input_stream, Output&& output, std::size_t first_offset = 0) const;
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_binary_cstream_to(FILE* input_stream, Output&& output, std::size_t first_offset = 0) const;
+    /**
+     * @brief Formats the bytes of a file window, read through a memory mapping where available.
+     * @param offset The position of the first byte of the window, which is also the first offset written.
+     * @param length The maximal size of the window, which ends at the end of the file at most.
+     * @throw std::system_error If the file cannot be opened or mapped.
+     * @throw std::out_of_range If offset is beyond the end of the file.
+     */
+    template <class Output>
+        requires BytesFormatterOutput<Output>
+    auto format_binary_file_to(const std::filesystem::path& file_path, Output&& output, std::size_t offset = 0,
+                               std::size_t length = std::dynamic_extent) const;
+
+    [[nodiscard]] std::string format_bytes(std::span<const std::byte> bytes, std::size_t first_offset = 0) const;
+    [[nodiscard]] std::string format_binary_stream(std::istream& input_stream, std::size_t first_offset = 0) const;
+    [[nodiscard]] std::string format_binary_cstream(FILE* input_stream, std::size_t first_offset = 0) const;
+    [[nodiscard]] std::string format_binary_file(const std::filesystem::path& file_path, std::size_t offset = 0,
+                                                 std::size_t length = std::dynamic_extent) const;
+
+private:
+    struct dump_state_
+    {
+        // Offset of the next byte to format.
+        std::size_t offset;
+        // Last full line formatted, used to detect duplicate lines.
+        std::array<std::byte, max_nb_bytes_per_line> previous_line{};
+        bool has_previous_line = false;
+        // Number of lines of the current run of duplicate lines, which are not written.
+        std::size_t nb_duplicate_lines = 0;
+        bool is_empty = true;
+    };
+
+    using byte_ranges_ = std::span<const std::pair<std::size_t, std::size_t>>;
+
+    // Bytes in holes, whose whole lines are zeros, are not read if duplicate lines are collapsed.
+    template <class Sink>
+    void format_bytes_to_sink_(std::span<const std::byte> bytes, Sink& sink, std::size_t offset,
+                               byte_ranges_ holes = {}) const;
+    template <class ReadBlock, class Sink>
+    void format_blocks_to_sink_(ReadBlock read_block, Sink& sink, std::size_t offset) const;
+
+    // Appends the lines of bytes, which start at a line boundary. The last one is partial at the end of the input
+    // only.
+    template <class Text>
+    void format_lines_to_(std::span<const std::byte> bytes, Text& text, dump_state_& state) const;
+    template <class Text>
+    void format_zero_lines_(std::size_t nb_lines, Text& text, dump_state_& state) const;
+    // Writes what replaces a run of nb_duplicate_lines lines identical to line, which ends at line_end_offset.
+    char* write_duplicate_run_(char* output, std::size_t nb_duplicate_lines, const std::byte* line,
+                               std::size_t line_end_offset) const;
+    // Appends what follows the last line: the end offset for hexdump and od, the end of a duplicate run for xxd.
+    template <class Text>
+    void format_end_to_(Text& text, const dump_state_& state) const;
+    // @return The number of whole lines at the beginning of bytes which are identical to previous_line, then to the
+    // line before them. With the xxd layout, these lines must also be zeros.
+    [[nodiscard]] std::size_t count_duplicate_lines_(std::span<const std::byte> bytes,
+                                                     const std::byte* previous_line) const;
+
+    char* write_xxd_line_(char* output, const std::byte* bytes, std::size_t nb_bytes, std::size_t offset) const;
+    char* write_hexdump_line_(char* output, const std::byte* bytes, std::size_t nb_bytes, std::size_t offset) const;
+    char* write_od_line_(char* output, const std::byte* bytes, std::size_t nb_bytes, std::size_t offset) const;
+
+    static constexpr std::array<std::byte, max_nb_bytes_per_line> zero_line_{};
+
+    [[nodiscard]] inline std::size_t block_size_() const
+    {
+        return buffer_size / nb_bytes_per_line_ * nb_bytes_per_line_;
+    }
+
+private:
+    hex_dump_layout layout_;
+    uint32_t nb_bytes_per_line_;
+    bool collapse_duplicate_lines_ = false;
+    // Upper bound of the size of a line, offset and new line included.
+    std::size_t max_line_size_;
+};
+
+inline hex_dump_formatter::hex_dump_formatter(hex_dump_layout layout, uint32_t nb_bytes_per_line)
+    : layout_(layout), nb_bytes_per_line_(nb_bytes_per_line)
+{
+    if (nb_bytes_per_line == 0 || nb_bytes_per_line % 2 != 0 || nb_bytes_per_line > max_nb_bytes_per_line)
+        [[unlikely]]
+        throw std::invalid_argument("The number of bytes per line must be even, between 2 and 256.");
+    // At most 22 octal digits of offset, 3 chars per byte in the hexadecimal area, and 1 in the ASCII gutter.
+    max_line_size_ = 32 + 5 * std::size_t(nb_bytes_per_line);
+}
+
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto hex_dump_formatter::format_bytes_to(std::span<const std::byte> bytes, Output&& output,
+                                                std::size_t first_offset) const
+{
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_bytes_to_sink_(bytes, sink, first_offset);
+    return private_::text_sink_result_(sink);
+}
+
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto hex_dump_formatter::format_binary_stream_to(std::istream& input_stream, Output&& output,
+                                                        std::size_t first_offset) const
+{
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_blocks_to_sink_(
+        [&input_stream](std::span<std::byte> block)
+        {
+            input_stream.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block.size()));
+            if (input_stream.bad()) [[unlikely]]
+                throw std::ios_base::failure("Failed to read the input stream.");
+            return static_cast<std::size_t>(input_stream.gcount());
+        },
+        sink, first_offset);
+    return private_::text_sink_result_(sink);
+}
+
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto hex_dump_formatter::format_binary_cstream_to(FILE* input_stream, Output&& output,
+                                                         std::size_t first_offset) const
+{
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_blocks_to_sink_(
+        [input_stream](std::span<std::byte> block)
+        {
+            const std::size_t nb_bytes = std::fread(block.data(), 1, block.size(), input_stream);
+            if (nb_bytes < block.size() && std::ferror(input_stream)) [[unlikely]]
+                throw std::system_error(errno, std::generic_category(), "Failed to read the input stream.");
+            return nb_bytes;
+        },
+        sink, first_offset);
+    return private_::text_sink_result_(sink);
+}
+
+template <class Output>
+    requires BytesFormatterOutput<Output>
+inline auto hex_dump_formatter::format_binary_file_to(const std::filesystem::path& file_path, Output&& output,
+                                                      std::size_t offset, std::size_t length) const
+{
+    const private_::mapped_file_window_ file_window(file_path, offset, length);
+    const std::vector<std::pair<std::size_t, std::size_t>> holes =
+        collapse_duplicate_lines_ ? file_window.holes() : std::vector<std::pair<std::size_t, std::size_t>>();
+    auto sink = private_::make_text_sink_(std::forward<Output>(output));
+    format_bytes_to_sink_(file_window.bytes(), sink, offset, holes);
+    return private_::text_sink_result_(sink);
+}
+
+inline std::string hex_dump_formatter::format_bytes(std::span<const std::byte> bytes, std::size_t first_offset) const
+{
+    std::string text;
+    format_bytes_to(bytes, text, first_offset);
+    return text;
+}
+
+inline std::string hex_dump_formatter::format_binary_stream(std::istream& input_stream,
+                                                            std::size_t first_offset) const
+{
+    std::string text;
+    format_binary_stream_to(input_stream, text, first_offset);
+    return text;
+}
+
+inline std::string hex_dump_formatter::format_binary_cstream(FILE* input_stream, std::size_t first_offset) const
+{
+    std::string text;
+    format_binary_cstream_to(input_stream, text, first_offset);
+    return text;
+}
+
+inline std::string hex_dump_formatter::format_binary_file(const std::filesystem::path& file_path, std::size_t offset,
+                                                          std::size_t length) const
+{
+    std::string text;
+    format_binary_file_to(file_path, text, offset, length);
+    return text;
+}
+
+template <class Sink>
+inline void hex_dump_formatter::format_bytes_to_sink_(std::span<const std::byte> bytes, Sink& sink,
+                                                      std::size_t offset, byte_ranges_ holes) const
+{
+    dump_state_ state{ .offset = offset };
+    std::size_t pos = 0;
+    const auto format_bytes_until = [&](std::size_t end)
+    {
+        for (const std::size_t block_size = block_size_(); pos < end;)
+        {
+            const std::size_t size = std::min(block_size, end - pos);
+            format_lines_to_(bytes.subspan(pos, size), sink.text(), state);
+            sink.flush();
+            pos += size;
+        }
+    };
+    if (collapse_duplicate_lines_)
+    {
+        for (const auto& [hole_begin, hole_end] : holes)
+        {
+            const std::size_t lines_begin =
+                std::max(pos, (hole_begin + nb_bytes_per_line_ - 1) / nb_bytes_per_line_ * nb_bytes_per_line_);
+            const std::size_t lines_end = hole_end / nb_bytes_per_line_ * nb_bytes_per_line_;
+            if (lines_begin >= lines_end)
+                continue;
+            format_bytes_until(lines_begin);
+            format_zero_lines_((lines_end - lines_begin) / nb_bytes_per_line_, sink.text(), state);
+            pos = lines_end;
+        }
+    }
+    format_bytes_until(bytes.size());
+    format_end_to_(sink.text(), state);
+    sink.flush();
+}
+
+// Blocks are whole lines, except the last one of the input.
+template <class ReadBlock, class Sink>
+inline void hex_dump_formatter::format_blocks_to_sink_(ReadBlock read_block, Sink& sink, std::size_t offset) const
+{
+    dump_state_ state{ .offset = offset };
+    private_::read_blocks_ahead_(block_size_(), read_block,
+                                 [&](std::span<const std::byte> block)
+                                 {
+                                     format_lines_to_(block, sink.text(), state);
+                                     sink.flush();
+                                 });
+    format_end_to_(sink.text(), state);
+    sink.flush();
+}
+
+template <class Text>
+inline void hex_dump_formatter::format_lines_to_(std::span<const std::byte> bytes, Text& text,
+                                                 dump_state_& state) const
+{
+    const std::size_t line_size = nb_bytes_per_line_;
+    const std::size_t nb_lines = (bytes.size() + line_size - 1) / line_size;
+    const std::size_t text_size = text.size();
+    // One more line for the end of a duplicate run begun before bytes.
+    text.resize(text_size + (nb_lines + 1) * max_line_size_);
+    char* output = text.data() + text_size;
+    for (std::size_t i = 0; i < bytes.size();)
+    {
+        const std::size_t nb_bytes = std::min(line_size, bytes.size() - i);
+        const std::byte* previous_line = i > 0 ? bytes.data() + i - line_size : state.previous_line.data();
+        if (collapse_duplicate_lines_ && nb_bytes == line_size && (i > 0 || state.has_previous_line))
+        {
+            if (const std::size_t nb_duplicate_lines = count_duplicate_lines_(bytes.subspan(i), previous_line);
+                nb_duplicate_lines > 0)
+            {
+                // xxd waits for the end of the run to know whether it is worth a "*" line.
+                if (state.nb_duplicate_lines == 0 && layout_ != hex_dump_layout::xxd)
+                    output = std::ranges::copy(std::string_view("*\n"), output).out;
+                state.nb_duplicate_lines += nb_duplicate_lines;
+                i += nb_duplicate_lines * line_size;
+                continue;
+            }
+        }
+        if (state.nb_duplicate_lines > 0)
+        {
+            if (layout_ == hex_dump_layout::xxd)
+                output = write_duplicate_run_(output, state.nb_duplicate_lines, previous_line, state.offset + i);
+            state.nb_duplicate_lines = 0;
+        }
+        switch (layout_)
+        {
+        case hex_dump_layout::xxd:
+            output = write_xxd_line_(output, bytes.data() + i, nb_bytes, state.offset + i);
+            break;
+        case hex_dump_layout::hexdump_canonical:
+            output = write_hexdump_line_(output, bytes.data() + i, nb_bytes, state.offset + i);
+            break;
+        case hex_dump_layout::od_hex:
+            output = write_od_line_(output, bytes.data() + i, nb_bytes, state.offset + i);
+            break;
+        }
+        i += nb_bytes;
+    }
+    text.resize(static_cast<std::size_t>(output - text.data()));
+
+    if (const std::size_t full_lines_end = bytes.size() / line_size * line_size; full_lines_end > 0)
+    {
+        std::copy_n(bytes.data() + full_lines_end - line_size, line_size, state.previous_line.data());
+        state.has_previous_line = true;
+    }
+    state.offset += bytes.size();
+    state.is_empty = state.is_empty && bytes.empty();
+}
+
+// Only the first line is formatted: the next ones are duplicates.
+template <class Text>
+inline void hex_dump_formatter::format_zero_lines_(std::size_t nb_lines, Text& text, dump_state_& state) const
+{
+    format_lines_to_(std::span(zero_line_).first(nb_bytes_per_line_), text, state);
+    if (nb_lines > 1)
+    {
+        if (state.nb_duplicate_lines == 0 && layout_ != hex_dump_layout::xxd)
+            private_::append_text_(text, "*\n");
+        state.nb_duplicate_lines += nb_lines - 1;
+        state.offset += (nb_lines - 1) * nb_bytes_per_line_;
+    }
+}
+
+// As xxd -a, a run of a single duplicate zero line is written, and the last line of the input is written even if it
+// is a duplicate.
+inline char* hex_dump_formatter::write_duplicate_run_(char* output, std::size_t nb_duplicate_lines,
+                                                      const std::byte* line, std::size_t line_end_offset) const
+{
+    if (nb_duplicate_lines == 1)
+        return write_xxd_line_(output, line, nb_bytes_per_line_, line_end_offset - nb_bytes_per_line_);
+    return std::ranges::copy(std::string_view("*\n"), output).out;
+}
+
+// hexdump writes nothing for an empty input, od writes its end offset whatever the input.
+template <class Text>
+inline void hex_dump_formatter::format_end_to_(Text& text, const dump_state_& state) const
+{
+    std::array<char, 32> end_offset_line;
+    char* output = end_offset_line.data();
+    switch (layout_)
+    {
+    case hex_dump_layout::xxd:
+        if (state.nb_duplicate_lines > 0)
+        {
+            const std::size_t text_size = text.size();
+            text.resize(text_size + 2 * max_line_size_);
+            char* line_end = text.data() + text_size;
+            const std::size_t last_line_offset = state.offset - nb_bytes_per_line_;
+            if (state.nb_duplicate_lines > 1)
+                line_end = write_duplicate_run_(line_end, state.nb_duplicate_lines - 1, state.previous_line.data(),
+                                                last_line_offset);
+            line_end = write_xxd_line_(line_end, state.previous_line.data(), nb_bytes_per_line_, last_line_offset);
+            text.resize(static_cast<std::size_t>(line_end - text.data()));
+        }
+        return;
+    case hex_dump_layout::hexdump_canonical:
+        if (state.is_empty)
+            return;
+        output = private_::write_offset_(output, state.offset, 4, 8);
+        break;
+    case hex_dump_layout::od_hex:
+        output = private_::write_offset_(output, state.offset, 3, 7);
+        break;
+    }
+    *output++ = '\n';
+    private_::append_text_(text, std::string_view(end_offset_line.data(), output));
+}
+
+// The first line is compared with previous_line, and the next ones with the line before them, which amounts to a
+// single compare of the bytes with themselves shifted by a line.
+inline std::size_t hex_dump_formatter::count_duplicate_lines_(std::span<const std::byte> bytes,
+                                                              const std::byte* previous_line) const
+{
+    if (std::memcmp(bytes.data(), previous_line, nb_bytes_per_line_) != 0)
+        return 0;
+    if (layout_ == hex_dump_layout::xxd && std::memcmp(bytes.data(), zero_line_.data(), nb_bytes_per_line_) != 0)
+        return 0;
+    const std::size_t full_lines_size = bytes.size() / nb_bytes_per_line_ * nb_bytes_per_line_;
+    return 1
+           + private_::find_mismatch_.select()(bytes.data() + nb_bytes_per_line_, bytes.data(),
+                                                full_lines_size - nb_bytes_per_line_)
+                 / nb_bytes_per_line_;
+}
+
+// The hexadecimal area is padded to its full width on a partial line, to align the ASCII gutter.
+inline char* hex_dump_formatter::write_xxd_line_(char* output, const std::byte* bytes, std::size_t nb_bytes,
+                                                 std::size_t offset) const
+{
+    output = private_::write_offset_(output, offset, 4, 8);
+    *output++ = ':';
+    for (std::size_t i = 0; i < nb_bytes_per_line_; i += 2)
+    {
+        *output++ = ' ';
+        for (std::size_t j = i; j < i + 2; ++j)
+        {
+            if (j < nb_bytes) [[likely]]
+                output = private_::write_hex_byte_(output, bytes[j]);
+            else
+                output = std::fill_n(output, 2, ' ');
+        }
+    }
+    output = std::fill_n(output, 2, ' ');
+    for (std::size_t i = 0; i < nb_bytes; ++i)
+        *output++ = private_::printable_chars_[static_cast<uint8_t>(bytes[i])];
+    *output++ = '\n';
+    return output;
+}
+
+inline char* hex_dump_formatter::write_hexdump_line_(char* output, const std::byte* bytes, std::size_t nb_bytes,
+                                                     std::size_t offset) const
+{
+    output = private_::write_offset_(output, offset, 4, 8);
+    *output++ = ' ';
+    for (std::size_t i = 0; i < nb_bytes_per_line_; ++i)
+    {
+        if (i % 8 == 0)
+            *output++ = ' ';
+        if (i < nb_bytes) [[likely]]
+            output = private_::write_hex_byte_(output, bytes[i]);
+        else
+            output = std::fill_n(output, 2, ' ');
+        *output++ = ' ';
+    }
+    *output++ = ' ';
+    *output++ = '|';
+    for (std::size_t i = 0; i < nb_bytes; ++i)
+        *output++ = private_::printable_chars_[static_cast<uint8_t>(bytes[i])];
+    *output++ = '|';
+    *output++ = '\n';
+    return output;
+}
+
+// Words are little-endian, an odd last byte being completed by a zero byte.
+inline char* hex_dump_formatter::write_od_line_(char* output, const std::byte* bytes, std::size_t nb_bytes,
+                                                std::size_t offset) const
+{
+    output = private_::write_offset_(output, offset, 3, 7);
+    for (std::size_t i = 0; i < nb_bytes; i += 2)
+    {
+        *output++ = ' ';
+        output = private_::write_hex_byte_(output, i + 1 < nb_bytes ? bytes[i + 1] : std::byte(0));
+        output = private_::write_hex_byte_(output, bytes[i]);
+    }
+    *output++ = '\n';
+    return output;
+}
+
+} // namespace core
+} // namespace arba
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <arba/core/bit/byte_swap_span.hpp>
+
+#include <bit>
+#include <compare>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+inline namespace arba
+{
+namespace core
+{
+
+namespace private_
+{
+template <typename Iterator>
+consteval auto byte_swap_iterator_concept_()
+{
+    if constexpr (std::random_access_iterator<Iterator>)
+        return std::random_access_iterator_tag{};
+    else if constexpr (std::bidirectional_iterator<Iterator>)
+        return std::bidirectional_iterator_tag{};
+    else if constexpr (std::forward_iterator<Iterator>)
+        return std::forward_iterator_tag{};
+    else
+        return std::input_iterator_tag{};
+}
+} // namespace private_
+
+/**
+ * @brief The byte_swap_iterator class returns the values of the underlying iterator, byte swapped if Swap is true.
+ *
+ * Values are swapped on dereference only, so that a partial scan or a binary search over foreign-endian data
+ * converts only the values it reads.
+ */
+template <std::input_iterator Iterator, bool Swap = true>
+    requires ByteSwappable<std::iter_value_t<Iterator>>
+class byte_swap_iterator
+{
+public:
+    using iterator_type = Iterator;
+    using iterator_concept = decltype(private_::byte_swap_iterator_concept_<Iterator>());
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::iter_value_t<Iterator>;
+    using difference_type = std::iter_difference_t<Iterator>;
+
+    byte_swap_iterator()
+        requires std::default_initializable<iterator_type>
+    = default;
+
+    explicit byte_swap_iterator(iterator_type iter) : current_(std::move(iter)) {}
+
+    [[nodiscard]] inline const iterator_type& base() const& { return current_; }
+    [[nodiscard]] inline iterator_type base() && { return std::move(current_); }
+
+    [[nodiscard]] inline value_type operator*() const
+    {
+        if constexpr (Swap)
+            return byte_swap(static_cast<value_type>(*current_));
+        else
+            return *current_;
+    }
+
+    [[nodiscard]] inline value_type operator[](const difference_type& offset) const
+        requires std::random_access_iterator<iterator_type>
+    {
+        return *(*this + offset);
+    }
+
+    inline byte_swap_iterator& operator++()
+    {
+        ++current_;
+        return *this;
+    }
+
+    inline void operator++(int)
+        requires(!std::forward_iterator<iterator_type>)
+    {
+        ++current_;
+    }
+
+    inline byte_swap_iterator operator++(int)
+        requires std::forward_iterator<iterator_type>
+    {
+        byte_swap_iterator aux(*this);
+        ++current_;
+        return aux;
+    }
+
+    inline byte_swap_iterator& operator--()
+        requires std::bidirectional_iterator<iterator_type>
+    {
+        --current_;
+        return *this;
+    }
+
+    inline byte_swap_iterator operator--(int)
+        requires std::bidirectional_iterator<iterator_type>
+    {
+        byte_swap_iterator aux(*this);
+        --current_;
+        return aux;
+    }
+
+    inline byte_swap_iterator& operator+=(const difference_type& offset)
+        requires std::random_access_iterator<iterator_type>
+    {
+        current_ += offset;
+        return *this;
+    }
+
+    inline byte_swap_iterator& operator-=(const difference_type& offset)
+        requires std::random_access_iterator<iterator_type>
+    {
+        current_ -= offset;
+        return *this;
+    }
+
+    [[nodiscard]] friend inline byte_swap_iterator operator+(byte_swap_iterator iter, const difference_type& offset)
+        requires std::random_access_iterator<iterator_type>
+    {
+        return iter += offset;
+    }
+
+    [[nodiscard]] friend inline byte_swap_iterator operator+(const difference_type& offset, byte_swap_iterator iter)
+        requires std::random_access_iterator<iterator_type>
+    {
+        return iter += offset;
+    }
+
+    [[nodiscard]] friend inline byte_swap_iterator operator-(byte_swap_iterator iter, const difference_type& offset)
+        requires std::random_access_iterator<iterator_type>
+    {
+        return iter -= offset;
+    }
+
+    [[nodiscard]] friend inline difference_type operator-(const byte_swap_iterator& lhs, const byte_swap_iterator& rhs)
+        requires std::sized_sentinel_for<iterator_type, iterator_type>
+    {
+        return lhs.current_ - rhs.current_;
+    }
+
+    [[nodiscard]] friend inline bool operator==(const byte_swap_iterator& lhs, const byte_swap_iterator& rhs)
+        requires std::equality_comparable<iterator_type>
+    {
+        return lhs.current_ == rhs.current_;
+    }
+
+    [[nodiscard]] friend inline auto operator<=>(const byte_swap_iterator& lhs, const byte_swap_iterator& rhs)
+        requires std::random_access_iterator<iterator_type> && std::three_way_comparable<iterator_type>
+    {
+        return lhs.current_ <=> rhs.current_;
+    }
+
+private:
+    iterator_type current_{};
+};
+
+/**
+ * @brief The byte_swap_sentinel class wraps the sentinel of a non-common range, to compare it with
+ * byte_swap_iterators.
+ */
+template <std::semiregular Sentinel>
+class byte_swap_sentinel
+{
+public:
+    byte_swap_sentinel() = default;
+
+    explicit byte_swap_sentinel(Sentinel sentinel) : sentinel_(std::move(sentinel)) {}
+
+    [[nodiscard]] inline const Sentinel& base() const { return sentinel_; }
+
+    template <typename Iterator, bool Swap>
+        requires std::sentinel_for<Sentinel, Iterator>
+    [[nodiscard]] friend inline bool operator==(const byte_swap_iterator<Iterator, Swap>& lhs,
+                                                const byte_swap_sentinel& rhs)
+    {
+        return lhs.base() == rhs.sentinel_;
+    }
+
+    template <typename Iterator, bool Swap>
+        requires std::sized_sentinel_for<Sentinel, Iterator>
+    [[nodiscard]] friend inline std::iter_difference_t<Iterator>
+    operator-(const byte_swap_sentinel& lhs, const byte_swap_iterator<Iterator, Swap>& rhs)
+    {
+        return lhs.sentinel_ - rhs.base();
+    }
+
+    template <typename Iterator, bool Swap>
+        requires std::sized_sentinel_for<Sentinel, Iterator>
+    [[nodiscard]] friend inline std::iter_difference_t<Iterator>
+    operator-(const byte_swap_iterator<Iterator, Swap>& lhs, const byte_swap_sentinel& rhs)
+    {
+        return lhs.base() - rhs.sentinel_;
+    }
+
+private:
+    Sentinel sentinel_{};
+};
+
+/**
+ * @brief The byte_swap_view class is a view of the values of View, byte swapped on access if Swap is true.
+ *
+ * It keeps the category (up to random access) and the size of View. Converting the whole view at once with
+ * copy_to() or to_vector() uses the bulk SIMD kernels when View is contiguous.
+ */
+template <std::ranges::view View, bool Swap = true>
+    requires std::ranges::input_range<const View> && ByteSwappable<std::ranges::range_value_t<View>>
+class byte_swap_view : public std::ranges::view_interface<byte_swap_view<View, Swap>>
+{
+public:
+    using iterator = byte_swap_iterator<std::ranges::iterator_t<const View>, Swap>;
+    using value_type = std::ranges::range_value_t<View>;
+
+    byte_swap_view()
+        requires std::default_initializable<View>
+    = default;
+
+    explicit byte_swap_view(View view) : view_(std::move(view)) {}
+
+    [[nodiscard]] inline View base() const&
+        requires std::copy_constructible<View>
+    {
+        return view_;
+    }
+    [[nodiscard]] inline View base() && { return std::move(view_); }
+
+    [[nodiscard]] inline iterator begin() const { return iterator(std::ranges::begin(view_)); }
+
+    [[nodiscard]] inline auto end() const
+    {
+        if constexpr (std::ranges::common_range<const View>)
+            return iterator(std::ranges::end(view_));
+        else
+            return byte_swap_sentinel(std::ranges::end(view_));
+    }
+
+    [[nodiscard]] inline auto size() const
+        requires std::ranges::sized_range<const View>
+    {
+        return std::ranges::size(view_);
+    }
+
+    // Copies the converted values to output, which must be large enough.
+    inline void copy_to(std::span<value_type> output) const
+    {
+        if constexpr (std::ranges::contiguous_range<const View> && std::ranges::sized_range<const View>
+                      && BulkByteSwappable<value_type>)
+        {
+            const std::size_t count = std::ranges::size(view_);
+            if (output.size() < count) [[unlikely]]
+                throw std::length_error("Output span is smaller than input range.");
+            const std::byte* input = reinterpret_cast<const std::byte*>(std::ranges::data(view_));
+            if constexpr (Swap)
+                private_::byte_swap_copy_values_<value_type>(input, reinterpret_cast<std::byte*>(output.data()),
+                                                             count);
+            else if (count > 0)
+                std::memcpy(output.data(), input, count * sizeof(value_type));
+        }
+        else
+        {
+            auto output_iter = output.begin();
+            for (auto iter = begin(); iter != end(); ++iter, ++output_iter)
+            {
+                if (output_iter == output.end()) [[unlikely]]
+                    throw std::length_error("Output span is smaller than input range.");
+                *output_iter = *iter;
+            }
+        }
+    }
+
+    [[nodiscard]] inline std::vector<value_type> to_vector() const
+    {
+        if constexpr (std::ranges::sized_range<const View>)
+        {
+            std::vector<value_type> values(std::ranges::size(view_));
+            copy_to(values);
+            return values;
+        }
+        else
+        {
+            std::vector<value_type> values;
+            for (auto iter = begin(); iter != end(); ++iter)
+                values.push_back(*iter);
+            return values;
+        }
+    }
+
+private:
+    View view_{};
+};
+
+template <typename Range, bool Swap = true>
+byte_swap_view(Range&&) -> byte_swap_view<std::views::all_t<Range>, Swap>;
+
+namespace private_
+{
+template <bool Swap>
+struct byte_swap_view_adaptor_
+{
+    template <std::ranges::viewable_range Range>
+    [[nodiscard]] inline auto operator()(Range&& range) const
+    {
+        return byte_swap_view<std::views::all_t<Range>, Swap>(std::views::all(std::forward<Range>(range)));
+    }
+
+    template <std::ranges::viewable_range Range>
+    [[nodiscard]] friend inline auto operator|(Range&& range, const byte_swap_view_adaptor_& adaptor)
+    {
+        return adaptor(std::forward<Range>(range));
+    }
+};
+} // namespace private_
+
+namespace views
+{
+// Byte swaps the values of a range on access: `values | views::byte_swapped` or `views::byte_swapped(values)`.
+inline constexpr private_::byte_swap_view_adaptor_<true> byte_swapped{};
+
+// Converts the values of a range from world (big endian) to host byte order on access.
+inline constexpr private_::byte_swap_view_adaptor_<std::endian::native == std::endian::little> wtoh{};
+
+// Converts the values of a range from host to world (big endian) byte order on access.
+inline constexpr private_::byte_swap_view_adaptor_<std::endian::native == std::endian::little> htow{};
+} // namespace views
+
+} // namespace core
+} // namespace arba
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+#if !defined(ARBA_CORE_DISABLE_SIMD)                                                                                   \
+    && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))                               \
+    && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define ARBA_CORE_SIMD_X86 1
+#endif
+
+// BMI2 enabled at compile time (-mbmi2 or -march), with its 64-bit forms: _pdep_u64, _pext_u64.
+#if defined(ARBA_CORE_SIMD_X86) && defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+#define ARBA_CORE_HAS_BMI2_64 1
+#endif
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief The simd_level enum lists the instruction set levels SIMD kernels can be specialized for.
+ *
+ * Each level implies all the previous ones.
+ */
+enum class simd_level : uint8_t
+{
+    scalar,
+    sse2,
+    ssse3,
+    sse4_2,
+    avx2,   // + BMI1, BMI2, POPCNT
+    avx512, // F, BW, DQ, VL
+};
+
+inline constexpr std::size_t nb_simd_levels = static_cast<std::size_t>(simd_level::avx512) + 1;
+
+[[nodiscard]] inline constexpr std::string_view to_string_view(simd_level level)
+{
+    constexpr std::array<std::string_view, nb_simd_levels> names = { "scalar", "sse2", "ssse3",
+                                                                     "sse4_2", "avx2", "avx512" };
+    return names[static_cast<std::size_t>(level)];
+}
+
+[[nodiscard]] inline constexpr std::optional<simd_level> to_simd_level(std::string_view name)
+{
+    for (std::size_t i = 0; i < nb_simd_levels; ++i)
+        if (to_string_view(static_cast<simd_level>(i)) == name)
+            return static_cast<simd_level>(i);
+    return std::nullopt;
+}
+
+/**
+ * @brief The cpu_features struct lists the CPU features used by the library SIMD kernels.
+ */
+struct cpu_features
+{
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse4_1 = false;
+    bool sse4_2 = false;
+    bool popcnt = false;
+    bool avx2 = false;
+    bool bmi1 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512dq = false;
+    bool avx512vl = false;
+    bool avx512vpopcntdq = false;
+
+    [[nodiscard]] inline constexpr simd_level level() const
+    {
+        if (!sse2)
+            return simd_level::scalar;
+        if (!ssse3)
+            return simd_level::sse2;
+        if (!(sse4_1 && sse4_2 && popcnt))
+            return simd_level::ssse3;
+        if (!(avx2 && bmi1 && bmi2))
+            return simd_level::sse4_2;
+        if (!(avx512f && avx512bw && avx512dq && avx512vl))
+            return simd_level::avx2;
+        return simd_level::avx512;
+    }
+};
+
+namespace private_
+{
+inline cpu_features probe_cpu_features_()
+{
+    cpu_features features;
+#if defined(ARBA_CORE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    features.sse2 = __builtin_cpu_supports("sse2");
+    features.ssse3 = __builtin_cpu_supports("ssse3");
+    features.sse4_1 = __builtin_cpu_supports("sse4.1");
+    features.sse4_2 = __builtin_cpu_supports("sse4.2");
+    features.popcnt = __builtin_cpu_supports("popcnt");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.bmi1 = __builtin_cpu_supports("bmi");
+    features.bmi2 = __builtin_cpu_supports("bmi2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+    features.avx512bw = __builtin_cpu_supports("avx512bw");
+    features.avx512dq = __builtin_cpu_supports("avx512dq");
+    features.avx512vl = __builtin_cpu_supports("avx512vl");
+    features.avx512vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq");
+#elif defined(ARBA_CORE_SIMD_X86) && defined(_MSC_VER)
+    const auto has_bit = [](uint32_t reg, unsigned index) { return ((reg >> index) & 1u) != 0; };
+    std::array<int, 4> regs;
+    __cpuid(regs.data(), 0);
+    const int max_leaf = regs[0];
+    __cpuid(regs.data(), 1);
+    const uint32_t ecx1 = static_cast<uint32_t>(regs[2]);
+    const uint32_t edx1 = static_cast<uint32_t>(regs[3]);
+    features.sse2 = has_bit(edx1, 26);
+    features.ssse3 = has_bit(ecx1, 9);
+    features.sse4_1 = has_bit(ecx1, 19);
+    features.sse4_2 = has_bit(ecx1, 20);
+    features.popcnt = has_bit(ecx1, 23);
+    const bool os_saves_ymm = has_bit(ecx1, 27) && (_xgetbv(0) & 0x6) == 0x6;
+    const bool os_saves_zmm = os_saves_ymm && (_xgetbv(0) & 0xe6) == 0xe6;
+    if (max_leaf >= 7)
+    {
+        __cpuidex(regs.data(), 7, 0);
+        const uint32_t ebx7 = static_cast<uint32_t>(regs[1]);
+        const uint32_t ecx7 = static_cast<uint32_t>(regs[2]);
+        features.avx2 = os_saves_ymm && has_bit(ebx7, 5);
+        features.bmi1 = has_bit(ebx7, 3);
+        features.bmi2 = has_bit(ebx7, 8);
+        features.avx512f = os_saves_zmm && has_bit(ebx7, 16);
+        features.avx512dq = os_saves_zmm && has_bit(ebx7, 17);
+        features.avx512bw = os_saves_zmm && has_bit(ebx7, 30);
+        features.avx512vl = os_saves_zmm && has_bit(ebx7, 31);
+        features.avx512vpopcntdq = os_saves_zmm && has_bit(ecx7, 14);
+    }
+#endif
+    return features;
+}
+
+// The level used when none is forced: the detected one, possibly capped by the ARBA_CORE_SIMD_LEVEL
+// environment variable.
+inline simd_level default_simd_level_(simd_level detected_level)
+{
+    const char* env_value = std::getenv("ARBA_CORE_SIMD_LEVEL");
+    if (env_value == nullptr)
+        return detected_level;
+    const std::optional<simd_level> env_level = to_simd_level(env_value);
+    return env_level ? std::min(*env_level, detected_level) : detected_level;
+}
+
+inline constexpr uint8_t no_forced_simd_level_ = 0xff;
+inline std::atomic<uint8_t> forced_simd_level_{ no_forced_simd_level_ };
+} // namespace private_
+
+/**
+ * @brief Returns the features of the running CPU. They are probed once, on first call.
+ */
+[[nodiscard]] inline const cpu_features& detected_cpu_features()
+{
+    static const cpu_features features = private_::probe_cpu_features_();
+    return features;
+}
+
+[[nodiscard]] inline simd_level detected_simd_level()
+{
+    return detected_cpu_features().level();
+}
+
+/**
+ * @brief Returns the level SIMD kernels must be selected for.
+ *
+ * It is the detected level, unless it is lowered with the ARBA_CORE_SIMD_LEVEL environment variable
+ * or force_simd_level(). It is never higher than the detected level.
+ */
+[[nodiscard]] inline simd_level active_simd_level()
+{
+    static const simd_level default_level = private_::default_simd_level_(detected_simd_level());
+    const uint8_t forced_level = private_::forced_simd_level_.load(std::memory_order_relaxed);
+    if (forced_level == private_::no_forced_simd_level_) [[likely]]
+        return default_level;
+    return std::min(static_cast<simd_level>(forced_level), detected_simd_level());
+}
+
+/**
+ * @brief Forces the SIMD level used by the kernels (mainly for testing). A level higher than the detected
+ * one is clamped to the detected one.
+ */
+inline void force_simd_level(simd_level level)
+{
+    private_::forced_simd_level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+inline void reset_simd_level()
+{
+    private_::forced_simd_level_.store(private_::no_forced_simd_level_, std::memory_order_relaxed);
+}
+
+} // namespace core
+} // namespace arba
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "cpu_features.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#if defined(ARBA_CORE_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+// ARBA_CORE_TARGET(features) lets a function use instructions which are not enabled by the compilation flags,
+// so that it can be selected at run time by a simd_dispatcher.
+#if defined(ARBA_CORE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ARBA_CORE_TARGET(features) __attribute__((target(features)))
+#else
+#define ARBA_CORE_TARGET(features)
+#endif
+
+inline namespace arba
+{
+namespace core
+{
+
+/**
+ * @brief The simd_dispatcher class holds the variants of a kernel, one per SIMD level at most, and calls
+ * the best one available for active_simd_level().
+ *
+ * The scalar variant is mandatory. Dispatchers are meant to be constexpr variables, the selection costing
+ * one relaxed atomic load per call: kernels should be called once per buffer, not once per element.
+ *
+ * @code
+ * inline constexpr auto my_kernel = simd_dispatcher(&my_kernel_scalar)
+ *                                       .with(simd_level::avx2, &my_kernel_avx2);
+ * my_kernel(input, output, count);
+ * @endcode
+ */
+template <typename FunctionType>
+    requires std::is_function_v<FunctionType>
+class simd_dispatcher
+{
+public:
+    using function_pointer = FunctionType*;
+
+    explicit constexpr simd_dispatcher(function_pointer scalar_variant) { variants_[0] = scalar_variant; }
+
+    [[nodiscard]] constexpr simd_dispatcher with(simd_level level, function_pointer variant) const
+    {
+        simd_dispatcher result(*this);
+#if defined(ARBA_CORE_SIMD_X86)
+        result.variants_[static_cast<std::size_t>(level)] = variant;
+#else
+        (void)level;
+        (void)variant;
+#endif
+        return result;
+    }
+
+    [[nodiscard]] constexpr function_pointer variant(simd_level level) const
+    {
+        for (std::size_t i = static_cast<std::size_t>(level); i > 0; --i)
+            if (variants_[i] != nullptr)
+                return variants_[i];
+        return variants_[0];
+    }
+
+    [[nodiscard]] inline function_pointer select() const { return variant(active_simd_level()); }
+
+    template <typename... Args>
+    inline decltype(auto) operator()(Args&&... args) const
+    {
+        return select()(std::forward<Args>(args)...);
+    }
+
+private:
+    std::array<function_pointer, nb_simd_levels> variants_{};
+};
+
+template <typename FunctionType>
+simd_dispatcher(FunctionType*) -> simd_dispatcher<FunctionType>;
+
+} // namespace core
+} // namespace arba
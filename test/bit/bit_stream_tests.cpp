@@ -0,0 +1,226 @@
+#include "for_each_simd_level.hpp"
+#include <arba/core/bit/bit_stream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+// Reference implementation: one bit at a time.
+template <core::bit_order Order>
+uint64_t read_bits_slowly(std::span<const std::byte> bytes, std::size_t bit_position, unsigned nb_bits)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < nb_bits; ++i, ++bit_position)
+    {
+        const uint8_t byte = static_cast<uint8_t>(bytes[bit_position / 8]);
+        if constexpr (Order == core::bit_order::msb_first)
+            value = value << 1 | ((byte >> (7 - bit_position % 8)) & 1);
+        else
+            value |= uint64_t((byte >> (bit_position % 8)) & 1) << i;
+    }
+    return value;
+}
+
+std::vector<std::byte> make_bytes(std::size_t size)
+{
+    std::vector<std::byte> bytes(size);
+    for (std::size_t i = 0; i < size; ++i)
+        bytes[i] = static_cast<std::byte>(i * 2654435761u >> 13);
+    return bytes;
+}
+
+template <core::bit_order Order>
+void check_read_fields()
+{
+    const std::vector<std::byte> bytes = make_bytes(300);
+    core::bit_reader<Order> reader(bytes);
+    std::size_t bit_position = 0;
+    for (unsigned nb_bits = 0; reader.remaining_bits() >= nb_bits; nb_bits = (nb_bits * 7 + 3) % 65)
+    {
+        ASSERT_EQ(reader.read(nb_bits), read_bits_slowly<Order>(bytes, bit_position, nb_bits)) << nb_bits;
+        bit_position += nb_bits;
+        ASSERT_EQ(reader.bit_position(), bit_position);
+    }
+    ASSERT_THROW(static_cast<void>(reader.read(static_cast<unsigned>(reader.remaining_bits() + 1), cppx::maythrow)),
+                 std::out_of_range);
+}
+
+template <core::bit_order Order, typename T>
+void check_read_span(unsigned nb_bits, std::size_t count, std::size_t first_bit_position)
+{
+    const std::vector<std::byte> bytes = make_bytes((first_bit_position + count * nb_bits + 7) / 8);
+    ut::for_each_simd_level(
+        [&]
+        {
+            core::bit_reader<Order> reader(bytes);
+            reader.skip(first_bit_position);
+            std::vector<T> values(count);
+            reader.read(std::span(values), nb_bits);
+            for (std::size_t i = 0; i < count; ++i)
+                ASSERT_EQ(values[i], read_bits_slowly<Order>(bytes, first_bit_position + i * nb_bits, nb_bits))
+                    << nb_bits << " " << i;
+            ASSERT_EQ(reader.bit_position(), first_bit_position + count * nb_bits);
+        });
+}
+
+template <core::bit_order Order>
+void check_write_read()
+{
+    std::vector<std::byte> bytes(300);
+    core::bit_writer<Order> writer(bytes);
+    std::vector<std::pair<uint64_t, unsigned>> fields;
+    for (unsigned i = 0, nb_bits = 1; writer.remaining_bits() >= nb_bits; ++i, nb_bits = (nb_bits * 7 + 3) % 65)
+    {
+        const uint64_t hash = i * 0x9e3779b97f4a7c15ULL;
+        const uint64_t value = nb_bits == 64 ? hash : hash & ((uint64_t(1) << nb_bits) - 1);
+        writer.write(value, nb_bits);
+        fields.emplace_back(value, nb_bits);
+    }
+    core::bit_reader<Order> reader(writer.written_bytes());
+    for (const auto& [value, nb_bits] : fields)
+        ASSERT_EQ(reader.read(nb_bits), value) << nb_bits;
+    ASSERT_LT(reader.remaining_bits(), 8);
+}
+} // namespace
+
+TEST(bit_stream_tests, read__msb_first__ok)
+{
+    const std::vector bytes{ std::byte{ 0b1011'0011 }, std::byte{ 0b1000'1111 }, std::byte{ 0xff } };
+    core::bit_reader reader(bytes);
+    ASSERT_EQ(reader.read(3), 0b101u);
+    ASSERT_EQ(reader.read(11), 0b1'0011'1000'11u);
+    ASSERT_EQ(reader.peek(2, cppx::maythrow), 0b11u);
+    ASSERT_TRUE(reader.read_bit(cppx::maythrow));
+    ASSERT_EQ(reader.bit_position(), 15);
+    ASSERT_EQ(reader.remaining_bits(), 9);
+}
+
+TEST(bit_stream_tests, read__lsb_first__ok)
+{
+    const std::vector bytes{ std::byte{ 0b1011'0011 }, std::byte{ 0b1000'1111 } };
+    core::bit_reader<core::bit_order::lsb_first> reader(bytes);
+    ASSERT_EQ(reader.read(3), 0b011u);
+    ASSERT_EQ(reader.read(11), 0b00'1111'1011'0u);
+    ASSERT_EQ(reader.read(2), 0b10u);
+    ASSERT_TRUE(reader.empty());
+}
+
+TEST(bit_stream_tests, read__various_sizes__ok)
+{
+    check_read_fields<core::bit_order::msb_first>();
+    check_read_fields<core::bit_order::lsb_first>();
+}
+
+TEST(bit_stream_tests, read__too_large_field__exception)
+{
+    const std::vector<std::byte> bytes(16);
+    core::bit_reader reader(bytes);
+    ASSERT_THROW(static_cast<void>(reader.read(65, cppx::maythrow)), std::invalid_argument);
+    ASSERT_THROW(static_cast<void>(reader.peek(57, cppx::maythrow)), std::invalid_argument);
+    std::array<uint8_t, 2> values{};
+    ASSERT_THROW(reader.read(std::span(values), 9, cppx::maythrow), std::invalid_argument);
+    std::vector<std::byte> output_bytes(16);
+    core::bit_writer writer(output_bytes);
+    ASSERT_THROW(writer.write(0, 65, cppx::maythrow), std::invalid_argument);
+}
+
+TEST(bit_stream_tests, seek_skip_align__ok)
+{
+    const std::vector<std::byte> bytes = make_bytes(32);
+    core::bit_reader reader(bytes);
+    reader.seek(77, cppx::maythrow);
+    ASSERT_EQ(reader.read(27), (read_bits_slowly<core::bit_order::msb_first>(bytes, 77, 27)));
+    reader.skip(3);
+    ASSERT_EQ(reader.bit_position(), 107);
+    reader.align_to_byte();
+    ASSERT_EQ(reader.bit_position(), 112);
+    ASSERT_EQ(reader.read(8), static_cast<uint8_t>(bytes[14]));
+    ASSERT_THROW(reader.seek(257, cppx::maythrow), std::out_of_range);
+    ASSERT_THROW(reader.skip(200, cppx::maythrow), std::out_of_range);
+}
+
+TEST(bit_stream_tests, read_span__common_widths__ok)
+{
+    for (const unsigned nb_bits : { 1u, 3u, 7u, 8u, 11u, 16u, 25u, 27u, 32u, 57u, 64u })
+    {
+        check_read_span<core::bit_order::msb_first, uint64_t>(nb_bits, 100, 5);
+        check_read_span<core::bit_order::lsb_first, uint64_t>(nb_bits, 100, 5);
+    }
+    for (const unsigned nb_bits : { 3u, 11u, 25u, 32u })
+    {
+        check_read_span<core::bit_order::msb_first, uint32_t>(nb_bits, 37, 0);
+        check_read_span<core::bit_order::lsb_first, uint32_t>(nb_bits, 37, 3);
+    }
+    check_read_span<core::bit_order::msb_first, uint16_t>(11, 50, 1);
+    check_read_span<core::bit_order::lsb_first, uint8_t>(3, 50, 7);
+}
+
+TEST(bit_stream_tests, read_span__not_enough_bits__exception)
+{
+    const std::vector<std::byte> bytes(4);
+    core::bit_reader reader(bytes);
+    std::array<uint32_t, 3> values{};
+    ASSERT_THROW(reader.read(std::span(values), 11, cppx::maythrow), std::out_of_range);
+    ASSERT_EQ(reader.bit_position(), 0);
+}
+
+TEST(bit_stream_tests, write__msb_first__ok)
+{
+    std::vector<std::byte> bytes(3);
+    core::bit_writer writer(bytes);
+    writer.write(0b101, 3);
+    writer.write(0b1'0011'1000'11, 11);
+    writer.write_bit(true, cppx::maythrow);
+    ASSERT_EQ(writer.bit_position(), 15);
+    ASSERT_EQ(writer.written_bytes().size(), 2);
+    ASSERT_EQ(bytes[0], std::byte{ 0b1011'0011 });
+    ASSERT_EQ(bytes[1], std::byte{ 0b1000'1110 });
+    writer.align_to_byte();
+    writer.write(0xff, 8);
+    ASSERT_EQ(bytes[2], std::byte{ 0xff });
+    ASSERT_THROW(writer.write(1, 1, cppx::maythrow), std::length_error);
+}
+
+TEST(bit_stream_tests, write__lsb_first__ok)
+{
+    std::vector<std::byte> bytes(2);
+    core::bit_writer<core::bit_order::lsb_first> writer(bytes);
+    writer.write(0b011, 3);
+    writer.write(0b00'1111'1011'0, 11);
+    writer.write(0b10, 2);
+    ASSERT_EQ(bytes[0], std::byte{ 0b1011'0011 });
+    ASSERT_EQ(bytes[1], std::byte{ 0b1000'1111 });
+    ASSERT_EQ(writer.remaining_bits(), 0);
+}
+
+TEST(bit_stream_tests, write__value_wider_than_field__truncated)
+{
+    std::vector<std::byte> bytes(1);
+    core::bit_writer writer(bytes);
+    writer.write(0xff, 4);
+    ASSERT_EQ(bytes[0], std::byte{ 0xf0 });
+}
+
+TEST(bit_stream_tests, write_read__various_sizes__ok)
+{
+    check_write_read<core::bit_order::msb_first>();
+    check_write_read<core::bit_order::lsb_first>();
+}
+
+TEST(bit_stream_tests, write_span__ok)
+{
+    const std::array<uint16_t, 5> values{ 1, 2, 3, 2047, 0 };
+    std::vector<std::byte> bytes(8);
+    core::bit_writer writer(bytes);
+    writer.write(std::span(values), 11, cppx::maythrow);
+    ASSERT_EQ(writer.bit_position(), 55);
+    core::bit_reader reader(writer.written_bytes());
+    std::array<uint16_t, 5> read_values{};
+    reader.read(std::span(read_values), 11);
+    ASSERT_EQ(read_values, values);
+    ASSERT_THROW(writer.write(std::span(values), 11, cppx::maythrow), std::length_error);
+}
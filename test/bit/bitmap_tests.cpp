@@ -0,0 +1,163 @@
+#include "for_each_simd_level.hpp"
+#include <arba/core/bit/bitmap.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace
+{
+std::vector<uint64_t> make_bitmap(std::size_t nb_words, unsigned density_shift)
+{
+    std::vector<uint64_t> words(nb_words);
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (uint64_t& word : words)
+    {
+        word = ~uint64_t(0);
+        for (unsigned i = 0; i < density_shift; ++i)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            word &= state >> 7 | state << 57;
+        }
+    }
+    return words;
+}
+
+bool test_bit(std::span<const uint64_t> words, std::size_t bit_position)
+{
+    return (words[bit_position / 64] >> (bit_position % 64)) & 1;
+}
+} // namespace
+
+TEST(bitmap_tests, popcount__various_sizes__ok)
+{
+    for (const std::size_t nb_words : { 0, 1, 3, 4, 7, 8, 9, 31, 100, 1001 })
+    {
+        const std::vector<uint64_t> words = make_bitmap(nb_words, 1);
+        std::size_t expected_count = 0;
+        for (std::size_t i = 0; i < nb_words * 64; ++i)
+            expected_count += test_bit(words, i);
+        ut::for_each_simd_level([&] { ASSERT_EQ(core::popcount(words), expected_count) << nb_words; });
+    }
+}
+
+TEST(bitmap_tests, find_first_set__ok)
+{
+    std::vector<uint64_t> words(100);
+    ut::for_each_simd_level([&] { ASSERT_EQ(core::find_first_set(words), core::bit_npos); });
+    for (const std::size_t bit_position : { 6399, 4100, 512, 63, 0 })
+    {
+        words[bit_position / 64] |= uint64_t(1) << (bit_position % 64);
+        ut::for_each_simd_level([&] { ASSERT_EQ(core::find_first_set(words), bit_position); });
+    }
+    ASSERT_EQ(core::find_first_set(std::span<const uint64_t>()), core::bit_npos);
+}
+
+TEST(bitmap_tests, find_next_set__iteration__ok)
+{
+    const std::vector<uint64_t> words = make_bitmap(50, 4);
+    std::vector<std::size_t> expected_positions;
+    for (std::size_t i = 0; i < words.size() * 64; ++i)
+        if (test_bit(words, i))
+            expected_positions.push_back(i);
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<std::size_t> positions;
+            for (std::size_t i = core::find_first_set(words); i != core::bit_npos;
+                 i = core::find_next_set(words, i + 1))
+                positions.push_back(i);
+            ASSERT_EQ(positions, expected_positions);
+        });
+    ASSERT_EQ(core::find_next_set(words, words.size() * 64), core::bit_npos);
+}
+
+TEST(bitmap_tests, bitwise_operations__ok)
+{
+    const std::vector<uint64_t> lhs = make_bitmap(37, 1);
+    const std::vector<uint64_t> rhs = make_bitmap(37, 2);
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<uint64_t> output(lhs.size());
+            core::bitwise_and(lhs, rhs, output);
+            for (std::size_t i = 0; i < lhs.size(); ++i)
+                ASSERT_EQ(output[i], lhs[i] & rhs[i]);
+            core::bitwise_or(lhs, rhs, output);
+            for (std::size_t i = 0; i < lhs.size(); ++i)
+                ASSERT_EQ(output[i], lhs[i] | rhs[i]);
+            core::bitwise_andnot(lhs, rhs, output);
+            for (std::size_t i = 0; i < lhs.size(); ++i)
+                ASSERT_EQ(output[i], lhs[i] & ~rhs[i]);
+        });
+}
+
+TEST(bitmap_tests, bitwise_and__in_place__ok)
+{
+    std::vector<uint64_t> lhs = make_bitmap(20, 1);
+    const std::vector<uint64_t> rhs = make_bitmap(20, 2);
+    std::vector<uint64_t> expected_words(lhs.size());
+    core::bitwise_and(lhs, rhs, expected_words);
+    core::bitwise_and(lhs, rhs, lhs);
+    ASSERT_EQ(lhs, expected_words);
+}
+
+TEST(bitmap_tests, bitwise_and__size_mismatch__exception)
+{
+    const std::vector<uint64_t> lhs(4);
+    const std::vector<uint64_t> rhs(3);
+    std::vector<uint64_t> output(4);
+    ASSERT_THROW(core::bitwise_and(lhs, rhs, output), std::length_error);
+    ASSERT_THROW(core::bitwise_or(lhs, lhs, std::span(output).first(3)), std::length_error);
+}
+
+TEST(bitmap_tests, rank_select__ok)
+{
+    for (const std::size_t nb_words : { 1, 8, 63, 64, 65, 300 })
+    {
+        for (const unsigned density_shift : { 0u, 1u, 5u })
+        {
+            const std::vector<uint64_t> words = make_bitmap(nb_words, density_shift);
+            const core::bitmap_rank_select index(words);
+            ASSERT_EQ(index.size(), nb_words * 64);
+            ASSERT_EQ(index.count(), core::popcount(words));
+            std::size_t rank = 0;
+            for (std::size_t i = 0; i < index.size(); ++i)
+            {
+                ASSERT_EQ(index.rank(i), rank) << i;
+                if (test_bit(words, i))
+                {
+                    ASSERT_EQ(index.select(rank), i) << rank;
+                    ++rank;
+                }
+            }
+            ASSERT_EQ(index.rank(index.size()), rank);
+            ASSERT_EQ(index.select(rank), core::bit_npos);
+        }
+    }
+}
+
+TEST(bitmap_tests, rank_select__sparse_bitmap__ok)
+{
+    std::vector<uint64_t> words(1000);
+    words[0] = 1;
+    words[999] = uint64_t(1) << 63;
+    const core::bitmap_rank_select index(words);
+    ASSERT_EQ(index.count(), 2);
+    ASSERT_EQ(index.select(0), 0);
+    ASSERT_EQ(index.select(1), 63999);
+    ASSERT_EQ(index.rank(63999), 1);
+    ASSERT_EQ(index.rank(64000), 2);
+    ASSERT_THROW(static_cast<void>(index.rank(64001)), std::out_of_range);
+}
+
+TEST(bitmap_tests, rank_select__empty_bitmap__ok)
+{
+    const core::bitmap_rank_select index(std::span<const uint64_t>{});
+    ASSERT_EQ(index.count(), 0);
+    ASSERT_EQ(index.rank(0), 0);
+    ASSERT_EQ(index.select(0), core::bit_npos);
+}
@@ -0,0 +1,280 @@
+#include "for_each_simd_level.hpp"
+#include <arba/core/bit/byte_swap_span.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+template <typename T>
+std::vector<T> make_values(std::size_t count)
+{
+    std::vector<T> values(count);
+    if constexpr (std::is_class_v<T>)
+    {
+        std::byte* bytes = reinterpret_cast<std::byte*>(values.data());
+        for (std::size_t i = 0; i < count * sizeof(T); ++i)
+            bytes[i] = static_cast<std::byte>(i * 2654435761u + 17);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = static_cast<T>(i * 2654435761u + 17);
+    }
+    return values;
+}
+
+template <typename T>
+void check_bulk_byte_swap_(std::size_t count)
+{
+    const std::vector<T> values = make_values<T>(count);
+    std::vector<T> expected_values(count);
+    std::ranges::transform(values, expected_values.begin(), [](T value) { return core::byte_swap(value); });
+
+    std::vector<T> swapped_values(count);
+    core::byte_swap_copy(std::span(values), std::span(swapped_values));
+    ASSERT_EQ(swapped_values, expected_values);
+
+    std::vector<T> in_place_values = values;
+    core::byte_swap(std::span(in_place_values));
+    ASSERT_EQ(in_place_values, expected_values);
+}
+
+template <typename T>
+void check_bulk_byte_swap(std::size_t count)
+{
+    ut::for_each_simd_level([count] { check_bulk_byte_swap_<T>(count); });
+}
+} // namespace
+
+TEST(byte_swap_span_tests, byte_swap__u16_span__ok)
+{
+    for (std::size_t count : { 0, 1, 7, 8, 31, 32, 33, 1000 })
+        check_bulk_byte_swap<uint16_t>(count);
+}
+
+TEST(byte_swap_span_tests, byte_swap__u32_span__ok)
+{
+    for (std::size_t count : { 0, 1, 3, 4, 15, 16, 17, 1000 })
+        check_bulk_byte_swap<uint32_t>(count);
+}
+
+TEST(byte_swap_span_tests, byte_swap__u64_span__ok)
+{
+    for (std::size_t count : { 0, 1, 2, 7, 8, 9, 1000 })
+        check_bulk_byte_swap<uint64_t>(count);
+}
+
+TEST(byte_swap_span_tests, byte_swap__signed_span__ok)
+{
+    check_bulk_byte_swap<int16_t>(123);
+    check_bulk_byte_swap<int32_t>(123);
+    check_bulk_byte_swap<int64_t>(123);
+}
+
+TEST(byte_swap_span_tests, byte_swap__char_span__ok)
+{
+    check_bulk_byte_swap<char16_t>(77);
+    check_bulk_byte_swap<char32_t>(77);
+}
+
+enum class bulk_enum_u32 : uint32_t
+{
+};
+
+TEST(byte_swap_span_tests, byte_swap__enum_span__ok)
+{
+    check_bulk_byte_swap<bulk_enum_u32>(77);
+}
+
+TEST(byte_swap_span_tests, byte_swap__float_span__ok)
+{
+    std::vector<float> values(101);
+    std::iota(values.begin(), values.end(), -12.358f);
+    std::vector<float> swapped_values(values.size());
+    core::byte_swap_copy(std::span(values), std::span(swapped_values));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(core::byte_swap(swapped_values[i]), values[i]);
+    core::byte_swap(std::span(swapped_values));
+    ASSERT_EQ(swapped_values, values);
+}
+
+TEST(byte_swap_span_tests, byte_swap__double_span__ok)
+{
+    std::vector<double> values(101);
+    std::iota(values.begin(), values.end(), -12.358);
+    std::vector<double> swapped_values(values.size());
+    core::byte_swap_copy(std::span(values), std::span(swapped_values));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(core::byte_swap(swapped_values[i]), values[i]);
+    core::byte_swap(std::span(swapped_values));
+    ASSERT_EQ(swapped_values, values);
+}
+
+TEST(byte_swap_span_tests, byte_swap_copy__unaligned_spans__ok)
+{
+    std::vector<std::byte> input_bytes(sizeof(uint32_t) * 50 + 1);
+    std::vector<std::byte> output_bytes(input_bytes.size());
+    for (std::size_t i = 0; i < input_bytes.size(); ++i)
+        input_bytes[i] = static_cast<std::byte>(i);
+    std::span<uint32_t> input(reinterpret_cast<uint32_t*>(input_bytes.data() + 1), 50);
+    std::span<uint32_t> output(reinterpret_cast<uint32_t*>(output_bytes.data() + 1), 50);
+    core::byte_swap_copy(input, output);
+    for (std::size_t i = 0; i < 50; ++i)
+    {
+        ASSERT_EQ(output_bytes[1 + 4 * i], input_bytes[4 + 4 * i]);
+        ASSERT_EQ(output_bytes[4 + 4 * i], input_bytes[1 + 4 * i]);
+    }
+}
+
+TEST(byte_swap_span_tests, byte_swap_copy__output_too_small__throw_length_error)
+{
+    const std::vector<uint32_t> values(10);
+    std::vector<uint32_t> swapped_values(9);
+    ASSERT_THROW(core::byte_swap_copy(std::span(values), std::span(swapped_values)), std::length_error);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(byte_swap_span_tests, byte_swap__u128_span__ok)
+{
+    for (std::size_t count : { 0, 1, 3, 4, 5, 1000 })
+        check_bulk_byte_swap<core::uint128_t>(count);
+    check_bulk_byte_swap<core::int128_t>(77);
+}
+#endif
+
+struct pair_u16
+{
+    uint16_t first;
+    uint16_t second;
+
+    bool operator==(const pair_u16&) const = default;
+};
+
+template <>
+struct core::byte_swap_fields<pair_u16> : core::byte_swap_field_list<&pair_u16::first, &pair_u16::second>
+{
+};
+
+struct message_header
+{
+    uint32_t size;
+    uint16_t type;
+    uint8_t version;
+    uint8_t flags;
+    uint64_t timestamp;
+
+    bool operator==(const message_header&) const = default;
+};
+
+template <>
+struct core::byte_swap_fields<message_header>
+    : core::byte_swap_field_list<&message_header::size, &message_header::type, &message_header::version,
+                                 &message_header::flags, &message_header::timestamp>
+{
+};
+
+struct message_12
+{
+    uint32_t id;
+    uint16_t values[2];
+    int32_t delta;
+
+    bool operator==(const message_12&) const = default;
+};
+
+template <>
+struct core::byte_swap_fields<message_12>
+    : core::byte_swap_field_list<&message_12::id, &message_12::values, &message_12::delta>
+{
+};
+
+struct message_40
+{
+    message_header header;
+    uint32_t ids[3];
+    uint8_t tag[4];
+    std::array<uint16_t, 4> counts;
+
+    bool operator==(const message_40&) const = default;
+};
+
+template <>
+struct core::byte_swap_fields<message_40>
+    : core::byte_swap_field_list<&message_40::header, &message_40::ids, &message_40::tag, &message_40::counts>
+{
+};
+
+struct message_320
+{
+    uint64_t values[40];
+
+    bool operator==(const message_320&) const = default;
+};
+
+template <>
+struct core::byte_swap_fields<message_320> : core::byte_swap_field_list<&message_320::values>
+{
+};
+
+TEST(byte_swap_span_tests, byte_swap__aggregate_span__ok)
+{
+    for (std::size_t count : { 0, 1, 7, 8, 16, 17, 1000 })
+    {
+        check_bulk_byte_swap<pair_u16>(count);
+        check_bulk_byte_swap<message_header>(count);
+        check_bulk_byte_swap<message_12>(count);
+        check_bulk_byte_swap<message_40>(count);
+    }
+    check_bulk_byte_swap<message_320>(5);
+}
+
+TEST(byte_swap_span_tests, byte_swap__aggregate_span_values__ok)
+{
+    std::vector<message_header> values(5, message_header{ 0x11223344, 0x5566, 7, 8, 0x0102030405060708 });
+    core::byte_swap(std::span(values));
+    for (const message_header& value : values)
+        ASSERT_EQ(value, (message_header{ 0x44332211, 0x6655, 7, 8, 0x0807060504030201 }));
+}
+
+// Trivially copyable, but not default constructible.
+struct tagged_u32
+{
+    explicit tagged_u32(uint32_t value) : value(value), tag(0xabcd) {}
+
+    uint32_t value;
+    uint16_t tag;
+    uint16_t padding = 0;
+
+    bool operator==(const tagged_u32&) const = default;
+};
+
+template <>
+struct core::byte_swap_fields<tagged_u32>
+    : core::byte_swap_field_list<&tagged_u32::value, &tagged_u32::tag, &tagged_u32::padding>
+{
+};
+
+static_assert(core::BulkByteSwappable<tagged_u32> && !std::is_default_constructible_v<tagged_u32>);
+
+TEST(byte_swap_span_tests, byte_swap__not_default_constructible_span__ok)
+{
+    const std::vector<tagged_u32> values(17, tagged_u32(0x11223344));
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<tagged_u32> swapped_values(values.size(), tagged_u32(0));
+            core::byte_swap_copy(std::span(values), std::span(swapped_values));
+            tagged_u32 expected_value(0x44332211);
+            expected_value.tag = 0xcdab;
+            for (const tagged_u32& value : swapped_values)
+                ASSERT_EQ(value, expected_value);
+            core::byte_swap(std::span(swapped_values));
+            ASSERT_EQ(swapped_values, values);
+        });
+}
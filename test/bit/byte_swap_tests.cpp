@@ -261,3 +261,96 @@ TEST(byte_swap_tests, test_byte_swap_enum_double)
     swapped_value = core::byte_swap(swapped_value);
     ASSERT_EQ(swapped_value, expected_value);
 }
+
+static_assert(core::byte_swap(uint16_t(0x1122)) == 0x2211);
+static_assert(core::byte_swap(uint32_t(0x11223344)) == 0x44332211);
+static_assert(core::byte_swap(uint64_t(0x1122334455667788)) == 0x8877665544332211);
+static_assert(core::byte_swap(int32_t(-268'435'457)) == -17);
+static_assert(core::byte_swap(enum_class_u32::Value) == enum_class_u32::Swapped_value);
+static_assert(core::byte_swap(core::byte_swap(-12.358)) == -12.358);
+
+#if defined(__SIZEOF_INT128__)
+TEST(byte_swap_tests, test_byte_swap_u128)
+{
+    core::uint128_t value = (core::uint128_t(0x0011223344556677) << 64) | 0x8899aabbccddeeff;
+    core::uint128_t swapped_value = core::byte_swap(value);
+    core::uint128_t expected_value = (core::uint128_t(0xffeeddccbbaa9988) << 64) | 0x7766554433221100;
+    ASSERT_TRUE(swapped_value == expected_value);
+    static_assert(core::byte_swap(core::byte_swap(core::uint128_t(12345))) == 12345);
+}
+
+TEST(byte_swap_tests, test_byte_swap_i128)
+{
+    core::int128_t value = -(core::int128_t(1) << 120) - 1;
+    core::int128_t swapped_value = core::byte_swap(value);
+    core::int128_t expected_value = -2;
+    ASSERT_TRUE(swapped_value == expected_value);
+}
+#endif
+
+TEST(byte_swap_tests, test_byte_swap_byte_array)
+{
+    constexpr std::array<std::byte, 6> value{ std::byte(1), std::byte(2), std::byte(3),
+                                              std::byte(4), std::byte(5), std::byte(6) };
+    constexpr std::array<std::byte, 6> swapped_value = core::byte_swap(value);
+    constexpr std::array<std::byte, 6> expected_value{ std::byte(6), std::byte(5), std::byte(4),
+                                                       std::byte(3), std::byte(2), std::byte(1) };
+    static_assert(swapped_value == expected_value);
+    static_assert(core::ByteSwappable<std::array<uint8_t, 16>>);
+    static_assert(!core::ByteSwappable<std::array<uint16_t, 4>>);
+}
+
+struct record_header
+{
+    uint32_t size;
+    uint16_t type;
+    uint8_t flags;
+    char tag[4];
+    int16_t offsets[2];
+    std::array<uint16_t, 2> ids;
+    enum_class_u32 kind;
+};
+
+template <>
+struct core::byte_swap_fields<record_header>
+    : core::byte_swap_field_list<&record_header::size, &record_header::type, &record_header::flags,
+                                 &record_header::tag, &record_header::offsets, &record_header::ids,
+                                 &record_header::kind>
+{
+};
+
+struct record
+{
+    record_header header;
+    double value;
+};
+
+template <>
+struct core::byte_swap_fields<record> : core::byte_swap_field_list<&record::header, &record::value>
+{
+};
+
+TEST(byte_swap_tests, test_byte_swap_aggregate)
+{
+    static_assert(core::ByteSwappable<record_header>);
+    static_assert(core::ByteSwappable<record>);
+    static_assert(!core::FieldwiseByteSwappable<std::array<uint8_t, 4>>);
+
+    constexpr record_header header{
+        0x11223344, 0x5566, 0x77, { 'a', 'b', 'c', 'd' }, { -4097, 1 }, { 0x1234, 0xabcd }, enum_class_u32::Value
+    };
+    constexpr record_header swapped_header = core::byte_swap(header);
+    static_assert(swapped_header.size == 0x44332211);
+    static_assert(swapped_header.type == 0x6655);
+    static_assert(swapped_header.flags == 0x77);
+    static_assert(swapped_header.tag[0] == 'a' && swapped_header.tag[3] == 'd');
+    static_assert(swapped_header.offsets[0] == -17 && swapped_header.offsets[1] == 0x100);
+    static_assert(swapped_header.ids[0] == 0x3412 && swapped_header.ids[1] == 0xcdab);
+    static_assert(swapped_header.kind == enum_class_u32::Swapped_value);
+
+    const record value{ header, -12.358 };
+    const record swapped_value = core::byte_swap(value);
+    ASSERT_EQ(swapped_value.header.size, 0x44332211u);
+    ASSERT_EQ(swapped_value.header.kind, enum_class_u32::Swapped_value);
+    ASSERT_EQ(swapped_value.value, core::byte_swap(-12.358));
+}
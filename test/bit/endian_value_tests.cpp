@@ -0,0 +1,115 @@
+#include <arba/core/bit/endian_value.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+static_assert(sizeof(core::big_endian<uint32_t>) == sizeof(uint32_t));
+static_assert(alignof(core::big_endian<uint64_t>) == 1);
+static_assert(std::is_trivially_copyable_v<core::little_endian<double>>);
+static_assert(std::is_trivially_default_constructible_v<core::little_endian<uint16_t>>);
+
+namespace
+{
+struct packet_header
+{
+    core::big_endian<uint16_t> type;
+    core::big_endian<uint32_t> length;
+    core::little_endian<uint16_t> flags;
+};
+static_assert(sizeof(packet_header) == 8);
+} // namespace
+
+TEST(endian_value_tests, value__big_endian__bytes_in_big_endian)
+{
+    core::big_endian<uint32_t> value(0x11223344);
+    ASSERT_EQ(value.value(), 0x11223344u);
+    ASSERT_EQ(value.bytes()[0], std::byte(0x11));
+    ASSERT_EQ(value.bytes()[3], std::byte(0x44));
+}
+
+TEST(endian_value_tests, value__little_endian__bytes_in_little_endian)
+{
+    core::little_endian<uint32_t> value(0x11223344);
+    ASSERT_EQ(static_cast<uint32_t>(value), 0x11223344u);
+    ASSERT_EQ(value.bytes()[0], std::byte(0x44));
+    ASSERT_EQ(value.bytes()[3], std::byte(0x11));
+}
+
+TEST(endian_value_tests, overlay__packed_struct__ok)
+{
+    const std::array<uint8_t, 9> bytes = { 0xff, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x01, 0x80 };
+    packet_header header;
+    std::memcpy(&header, bytes.data() + 1, sizeof(header));
+    ASSERT_EQ(header.type, 2);
+    ASSERT_EQ(header.length, 256u);
+    ASSERT_EQ(header.flags, 0x8001);
+}
+
+TEST(endian_value_tests, arithmetic__integer__ok)
+{
+    core::big_endian<int32_t> value(-5);
+    value += 10;
+    ASSERT_EQ(value, 5);
+    value *= 3;
+    ++value;
+    ASSERT_EQ(value.value(), 16);
+    ASSERT_EQ(value--, 16);
+    value <<= 2;
+    ASSERT_EQ(value, 60);
+    value |= 3;
+    value %= 7;
+    ASSERT_EQ(value, 0);
+    ASSERT_LT(value, core::big_endian<int32_t>(1));
+}
+
+TEST(endian_value_tests, arithmetic__floating_point__ok)
+{
+    core::little_endian<double> value(1.5);
+    value *= 2;
+    value -= 0.5;
+    ASSERT_EQ(value.value(), 2.5);
+}
+
+TEST(endian_value_tests, to_host__span__ok)
+{
+    const std::vector<uint32_t> values = { 1, 0x11223344, 0xffeeddcc, 42, 7, 8, 9, 10, 11 };
+    std::vector<core::big_endian<uint32_t>> big_values(values.size());
+    core::from_host(std::span(values), std::span(big_values));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(big_values[i].value(), values[i]);
+
+    std::vector<uint32_t> host_values(values.size());
+    core::to_host(std::span(big_values), std::span(host_values));
+    ASSERT_EQ(host_values, values);
+
+    std::vector<core::little_endian<uint32_t>> little_values(values.begin(), values.end());
+    core::to_host(std::span<const core::little_endian<uint32_t>>(little_values), std::span(host_values));
+    ASSERT_EQ(host_values, values);
+}
+
+TEST(endian_value_tests, to_host__byte_array_span__ok)
+{
+    using bytes_4 = std::array<std::byte, 4>;
+    const std::vector<bytes_4> values = {
+        bytes_4{ std::byte(1), std::byte(2), std::byte(3), std::byte(4) },
+        bytes_4{ std::byte(0xaa), std::byte(0xbb), std::byte(0xcc), std::byte(0xdd) },
+    };
+    std::vector<core::big_endian<bytes_4>> big_values(values.size());
+    core::from_host(std::span(values), std::span(big_values));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(big_values[i].value(), values[i]);
+
+    std::vector<bytes_4> host_values(values.size());
+    core::to_host(std::span(big_values), std::span(host_values));
+    ASSERT_EQ(host_values, values);
+}
+
+TEST(endian_value_tests, to_host__output_too_small__throw_length_error)
+{
+    const std::vector<core::big_endian<uint16_t>> values(3);
+    std::vector<uint16_t> host_values(2);
+    ASSERT_THROW(core::to_host(std::span(values), std::span(host_values)), std::length_error);
+}
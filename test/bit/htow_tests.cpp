@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <vector>
 
 TEST(htow_tests, test_htow_u16)
 {
@@ -315,3 +317,61 @@ TEST(htow_tests, test_htow_double)
         ASSERT_EQ(swapped_value, expected_value);
     }
 }
+
+TEST(htow_tests, test_htow_span_in_place)
+{
+    std::vector<uint32_t> values = { 0x11223344, 0x55667788, 0x99aabbcc, 0xddeeff00, 0x01020304 };
+    const std::vector<uint32_t> input_values = values;
+    core::htow(std::span(values));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(values[i], core::htow(input_values[i]));
+    core::wtoh(std::span(values));
+    ASSERT_EQ(values, input_values);
+}
+
+TEST(htow_tests, test_htow_span_copy)
+{
+    const std::vector<uint16_t> values = { 0x1122, 0x3344, 0x5566, 0x7788, 0x99aa, 0xbbcc, 0xddee, 0xff00, 0x0102 };
+    std::vector<uint16_t> world_values(values.size());
+    core::htow(std::span(values), std::span(world_values));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(world_values[i], core::htow(values[i]));
+    std::vector<uint16_t> host_values(values.size());
+    core::wtoh(std::span(world_values), std::span(host_values));
+    ASSERT_EQ(host_values, values);
+}
+
+TEST(htow_tests, test_htow_span_to_bytes)
+{
+    const std::vector<uint32_t> values = { 0x11223344, 0x55667788 };
+    std::vector<std::byte> bytes(values.size() * sizeof(uint32_t) + 1);
+    core::htow(std::span(values), std::span(bytes).subspan(1));
+    const std::vector<uint8_t> expected_bytes = { 0, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
+    ASSERT_TRUE(std::ranges::equal(std::as_bytes(std::span(expected_bytes)), bytes));
+
+    std::vector<uint32_t> host_values(values.size());
+    core::wtoh(std::span<const std::byte>(bytes).subspan(1), std::span(host_values));
+    ASSERT_EQ(host_values, values);
+}
+
+TEST(htow_tests, test_htow_span_to_bytes_output_too_small)
+{
+    const std::vector<uint64_t> values(3);
+    std::vector<std::byte> bytes(values.size() * sizeof(uint64_t) - 1);
+    ASSERT_THROW(core::htow(std::span(values), std::span(bytes)), std::length_error);
+}
+
+TEST(htow_tests, test_wtoh_span_from_bytes_bad_size)
+{
+    const std::vector<std::byte> bytes(7);
+    std::vector<uint32_t> values(2);
+    ASSERT_THROW(core::wtoh(std::span(bytes), std::span(values)), std::invalid_argument);
+}
+
+TEST(htow_tests, test_htow_constexpr)
+{
+    constexpr uint32_t world_value = core::htow(uint32_t(0x11223344));
+    static_assert(core::wtoh(world_value) == 0x11223344);
+    static_assert(std::endian::native != std::endian::little || world_value == 0x44332211);
+    static_assert(core::wtoh(core::htow(-12.358)) == -12.358);
+}
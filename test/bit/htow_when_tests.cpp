@@ -2,7 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <vector>
 
 TEST(htow_if_tests, htow_if__endianness_specific__ok)
 {
@@ -43,3 +45,78 @@ TEST(htow_if_tests, wtoh_if__endianness_neutral__ok)
         expected_value = 0x2211;
     ASSERT_EQ(swapped_value, expected_value);
 }
+
+TEST(htow_if_tests, htow_if__span_endianness_specific__ok)
+{
+    std::vector<uint32_t> values = { 0x11223344, 0x55667788, 0x99aabbcc };
+    const std::vector<uint32_t> input_values = values;
+    core::htow_when(std::span(values), cppx::endianness_specific);
+    ASSERT_EQ(values, input_values);
+    std::vector<uint32_t> output_values(values.size());
+    core::wtoh_when(std::span(values), std::span(output_values), cppx::endianness_specific);
+    ASSERT_EQ(output_values, input_values);
+}
+
+TEST(htow_if_tests, htow_if__span_endianness_neutral__ok)
+{
+    std::vector<uint32_t> values = { 0x11223344, 0x55667788, 0x99aabbcc };
+    const std::vector<uint32_t> input_values = values;
+    core::htow_when(std::span(values), cppx::endianness_neutral);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(values[i], core::htow(input_values[i]));
+    std::vector<uint32_t> output_values(values.size());
+    core::wtoh_when(std::span(values), std::span(output_values), cppx::endianness_neutral);
+    ASSERT_EQ(output_values, input_values);
+}
+
+TEST(htow_if_tests, htow_if__span_to_bytes_endianness_policy__ok)
+{
+    const std::vector<uint16_t> values = { 0x1122, 0x3344 };
+    std::vector<std::byte> bytes(values.size() * sizeof(uint16_t));
+    core::htow_when(std::span(values), std::span(bytes), cppx::endianness_neutral);
+    const std::vector<uint8_t> expected_bytes = { 0x11, 0x22, 0x33, 0x44 };
+    ASSERT_TRUE(std::ranges::equal(std::as_bytes(std::span(expected_bytes)), bytes));
+    std::vector<uint16_t> output_values(values.size());
+    core::wtoh_when(std::span(bytes), std::span(output_values), cppx::endianness_neutral);
+    ASSERT_EQ(output_values, values);
+
+    core::htow_when(std::span(values), std::span(bytes), cppx::endianness_specific);
+    ASSERT_TRUE(std::ranges::equal(std::as_bytes(std::span(values)), bytes));
+    core::wtoh_when(std::span(bytes), std::span(output_values), cppx::endianness_specific);
+    ASSERT_EQ(output_values, values);
+}
+
+TEST(htow_if_tests, htow_if__runtime_endianness__ok)
+{
+    const uint32_t value = 0x11223344;
+    ASSERT_EQ(core::htow_when(value, std::endian::native), value);
+    ASSERT_EQ(core::wtoh_when(value, std::endian::big), core::wtoh(value));
+    ASSERT_EQ(core::htow_when(value, std::endian::little), core::byte_swap(core::htow(value)));
+}
+
+TEST(htow_if_tests, wtoh_if__span_runtime_endianness__ok)
+{
+    const std::vector<uint8_t> little_endian_bytes = { 0x44, 0x33, 0x22, 0x11, 0x88, 0x77, 0x66, 0x55 };
+    const std::vector<uint8_t> big_endian_bytes = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
+    const std::vector<uint32_t> expected_values = { 0x11223344, 0x55667788 };
+    std::vector<uint32_t> values(expected_values.size());
+    core::wtoh_when(std::as_bytes(std::span(little_endian_bytes)), std::span(values), std::endian::little);
+    ASSERT_EQ(values, expected_values);
+    core::wtoh_when(std::as_bytes(std::span(big_endian_bytes)), std::span(values), std::endian::big);
+    ASSERT_EQ(values, expected_values);
+
+    std::vector<std::byte> bytes(big_endian_bytes.size());
+    core::htow_when(std::span(values), std::span(bytes), std::endian::big);
+    ASSERT_TRUE(std::ranges::equal(std::as_bytes(std::span(big_endian_bytes)), bytes));
+    core::htow_when(std::span(values), std::endian::little);
+    core::wtoh_when(std::span(values), std::endian::little);
+    ASSERT_EQ(values, expected_values);
+}
+
+TEST(htow_if_tests, htow_if__constexpr__ok)
+{
+    static_assert(core::htow_when(uint16_t(0x1122), std::endian::native) == 0x1122);
+    static_assert(core::wtoh_when(uint16_t(0x1122), cppx::endianness_specific) == 0x1122);
+    static_assert(core::wtoh_when(core::htow_when(uint64_t(42), cppx::endianness_neutral), cppx::endianness_neutral)
+                  == 42);
+}
@@ -0,0 +1,99 @@
+#include <arba/core/bit/load_store.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+constexpr std::array<std::byte, 9> test_bytes = { std::byte(0x00), std::byte(0x11), std::byte(0x22),
+                                                  std::byte(0x33), std::byte(0x44), std::byte(0x55),
+                                                  std::byte(0x66), std::byte(0x77), std::byte(0x88) };
+
+// Trivially copyable, but not default constructible.
+struct tagged_u32
+{
+    explicit tagged_u32(uint32_t value) : value(value) {}
+
+    uint32_t value;
+
+    bool operator==(const tagged_u32&) const = default;
+};
+
+tagged_u32 byte_swap(tagged_u32 value)
+{
+    return tagged_u32(core::byte_swap(value.value));
+}
+
+static_assert(core::EndianLoadable<tagged_u32> && !std::is_default_constructible_v<tagged_u32>);
+} // namespace
+
+TEST(load_store_tests, load_be__unaligned_offset__ok)
+{
+    ASSERT_EQ(core::load_be<uint8_t>(test_bytes, 1), 0x11);
+    ASSERT_EQ(core::load_be<uint16_t>(test_bytes, 1), 0x1122);
+    ASSERT_EQ(core::load_be<uint32_t>(test_bytes, 1), 0x11223344u);
+    ASSERT_EQ(core::load_be<uint64_t>(test_bytes, 1), 0x1122334455667788u);
+    ASSERT_EQ(core::load_be<int16_t>(test_bytes, 7), static_cast<int16_t>(0x7788));
+}
+
+TEST(load_store_tests, load_le__unaligned_offset__ok)
+{
+    ASSERT_EQ(core::load_le<uint16_t>(test_bytes, 1), 0x2211);
+    ASSERT_EQ(core::load_le<uint32_t>(test_bytes, 1), 0x44332211u);
+    ASSERT_EQ(core::load_le<uint64_t>(test_bytes, 1), 0x8877665544332211u);
+}
+
+TEST(load_store_tests, load__maythrow_out_of_range__throw_out_of_range)
+{
+    ASSERT_EQ(core::load_be<uint64_t>(test_bytes, 1, cppx::maythrow), 0x1122334455667788u);
+    ASSERT_THROW((void)core::load_be<uint64_t>(test_bytes, 2, cppx::maythrow), std::out_of_range);
+    ASSERT_THROW((void)core::load_le<uint16_t>(test_bytes, 10, cppx::maythrow), std::out_of_range);
+}
+
+TEST(load_store_tests, store_be__unaligned_offset__ok)
+{
+    std::array<std::byte, 9> bytes{};
+    core::store_be(bytes, 1, uint32_t(0x11223344));
+    core::store_be<uint16_t>(bytes, 5, 0x5566);
+    core::store_be(bytes, 7, int16_t(0x7788));
+    ASSERT_EQ(bytes, test_bytes);
+    ASSERT_EQ(core::load_be<uint64_t>(bytes, 1), 0x1122334455667788u);
+}
+
+TEST(load_store_tests, store_le__unaligned_offset__ok)
+{
+    std::array<std::byte, 9> bytes{};
+    core::store_le(bytes, 1, uint64_t(0x8877665544332211));
+    ASSERT_EQ(bytes, test_bytes);
+}
+
+TEST(load_store_tests, store__float_round_trip__ok)
+{
+    std::array<std::byte, 11> bytes{};
+    core::store_be(bytes, 1, -12.358);
+    core::store_le(bytes, 9, char16_t(0x1234));
+    ASSERT_EQ(core::load_be<double>(bytes, 1), -12.358);
+    ASSERT_EQ(core::load_le<char16_t>(bytes, 9), char16_t(0x1234));
+    ASSERT_EQ(bytes[9], std::byte(0x34));
+}
+
+TEST(load_store_tests, load_store__not_default_constructible__ok)
+{
+    ASSERT_EQ(core::load_be<tagged_u32>(test_bytes, 1), tagged_u32(0x11223344));
+    ASSERT_EQ(core::load_le<tagged_u32>(test_bytes, 1, cppx::maythrow), tagged_u32(0x44332211));
+    std::array<std::byte, 9> bytes{};
+    core::store_be(bytes, 1, tagged_u32(0x11223344));
+    core::store_le(bytes, 5, tagged_u32(0x88776655));
+    ASSERT_EQ(bytes, test_bytes);
+}
+
+TEST(load_store_tests, store__maythrow_out_of_range__throw_out_of_range)
+{
+    std::vector<std::byte> bytes(4);
+    core::store_le(bytes, 0, uint32_t(1), cppx::maythrow);
+    ASSERT_THROW(core::store_le(bytes, 1, uint32_t(1), cppx::maythrow), std::out_of_range);
+    ASSERT_THROW(core::store_be(bytes, 5, uint8_t(1), cppx::maythrow), std::out_of_range);
+}
@@ -0,0 +1,155 @@
+#include "for_each_simd_level.hpp"
+#include <arba/core/bit/morton.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+// Reference implementation: one bit at a time.
+uint64_t interleave_slowly(std::span<const uint32_t> coordinates, unsigned nb_bits)
+{
+    uint64_t code = 0;
+    for (unsigned i = 0; i < nb_bits; ++i)
+        for (std::size_t j = 0; j < coordinates.size(); ++j)
+            code |= uint64_t((coordinates[j] >> i) & 1) << (i * coordinates.size() + j);
+    return code;
+}
+
+std::vector<uint32_t> make_coordinates(std::size_t count, uint32_t seed)
+{
+    std::vector<uint32_t> coordinates(count);
+    for (std::size_t i = 0; i < count; ++i)
+        coordinates[i] = static_cast<uint32_t>((i + seed) * 2654435761u);
+    return coordinates;
+}
+} // namespace
+
+TEST(morton_tests, pdep__values__ok)
+{
+    static_assert(core::pdep(uint64_t(0b1011), uint64_t(0b1111'0000)) == 0b1011'0000);
+    static_assert(core::pdep(uint32_t(0b101), uint32_t(0b1010'1000)) == 0b1000'1000);
+    static_assert(core::pdep(uint8_t(0xff), uint8_t(0)) == 0);
+    ASSERT_EQ(core::pdep(uint64_t(0b101), uint64_t(0b1010'1000)), 0b1000'1000u);
+    ASSERT_EQ(core::pdep(~uint64_t(0), ~uint64_t(0)), ~uint64_t(0));
+    ASSERT_EQ(core::pdep(uint16_t(0b11), uint16_t(0x8001)), uint16_t(0x8001));
+}
+
+TEST(morton_tests, pext__values__ok)
+{
+    static_assert(core::pext(uint64_t(0b1011'0000), uint64_t(0b1111'0000)) == 0b1011);
+    static_assert(core::pext(uint32_t(0b1000'1000), uint32_t(0b1010'1000)) == 0b101);
+    ASSERT_EQ(core::pext(uint64_t(0b1000'1000), uint64_t(0b1010'1000)), 0b101u);
+    ASSERT_EQ(core::pext(~uint64_t(0), uint64_t(1) << 63), 1u);
+    for (uint64_t value : { uint64_t(0x0123456789abcdef), uint64_t(42) })
+        ASSERT_EQ(core::pdep(core::pext(value, uint64_t(0xf0f0f0f0f0f0f0f0)), uint64_t(0xf0f0f0f0f0f0f0f0)),
+                  value & 0xf0f0f0f0f0f0f0f0);
+}
+
+TEST(morton_tests, morton_2d__values__ok)
+{
+    static_assert(core::morton_encode_2d(0b11, 0b01) == 0b0111);
+    static_assert(core::morton_decode_2d(0b0111) == std::array<uint32_t, 2>{ 0b11, 0b01 });
+    static_assert(core::morton_encode_2d(0xffffffff, 0) == 0x5555555555555555);
+    for (const uint32_t x : { 0u, 1u, 0x12345678u, 0xffffffffu })
+    {
+        for (const uint32_t y : { 0u, 7u, 0x9abcdef0u, 0xffffffffu })
+        {
+            const std::array<uint32_t, 2> point{ x, y };
+            const uint64_t code = core::morton_encode_2d(x, y);
+            ASSERT_EQ(code, interleave_slowly(point, 32));
+            ASSERT_EQ(core::morton_decode_2d(code), point);
+        }
+    }
+}
+
+TEST(morton_tests, morton_3d__values__ok)
+{
+    static_assert(core::morton_encode_3d(1, 0, 1) == 0b101);
+    static_assert(core::morton_decode_3d(0b101'110) == std::array<uint32_t, 3>{ 0b10, 0b01, 0b11 });
+    const std::array<uint32_t, 3> point{ 0x1fffff, 0x123456 & 0x1fffff, 5 };
+    const uint64_t code = core::morton_encode_3d(point[0], point[1], point[2]);
+    ASSERT_EQ(code, interleave_slowly(point, 21));
+    ASSERT_EQ(core::morton_decode_3d(code), point);
+    ASSERT_EQ(core::morton_encode_3d(0xffffffff, 0, 0), 0x1249249249249249u);
+}
+
+TEST(morton_tests, morton_2d__spans__ok)
+{
+    for (const std::size_t count : { 0, 3, 4, 37 })
+    {
+        const std::vector<uint32_t> xs = make_coordinates(count, 1);
+        const std::vector<uint32_t> ys = make_coordinates(count, 2);
+        ut::for_each_simd_level(
+            [&]
+            {
+                std::vector<uint64_t> codes(count);
+                core::morton_encode_2d(xs, ys, codes);
+                for (std::size_t i = 0; i < count; ++i)
+                    ASSERT_EQ(codes[i], core::morton_encode_2d(xs[i], ys[i]));
+                std::vector<uint32_t> decoded_xs(count), decoded_ys(count);
+                core::morton_decode_2d(codes, decoded_xs, decoded_ys);
+                ASSERT_EQ(decoded_xs, xs);
+                ASSERT_EQ(decoded_ys, ys);
+            });
+    }
+}
+
+TEST(morton_tests, morton_3d__spans__ok)
+{
+    for (const std::size_t count : { 0, 3, 4, 37 })
+    {
+        std::vector<uint32_t> xs = make_coordinates(count, 1);
+        std::vector<uint32_t> ys = make_coordinates(count, 2);
+        std::vector<uint32_t> zs = make_coordinates(count, 3);
+        ut::for_each_simd_level(
+            [&]
+            {
+                std::vector<uint64_t> codes(count);
+                core::morton_encode_3d(xs, ys, zs, codes);
+                for (std::size_t i = 0; i < count; ++i)
+                    ASSERT_EQ(codes[i], core::morton_encode_3d(xs[i], ys[i], zs[i]));
+                std::vector<uint32_t> decoded_xs(count), decoded_ys(count), decoded_zs(count);
+                core::morton_decode_3d(codes, decoded_xs, decoded_ys, decoded_zs);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    ASSERT_EQ(decoded_xs[i], xs[i] & 0x1fffff);
+                    ASSERT_EQ(decoded_ys[i], ys[i] & 0x1fffff);
+                    ASSERT_EQ(decoded_zs[i], zs[i] & 0x1fffff);
+                }
+            });
+    }
+}
+
+TEST(morton_tests, pdep_pext__spans__ok)
+{
+    const uint64_t mask = 0x00ff00f0f0f0ff0f;
+    std::vector<uint64_t> values(21);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = i * 0x9e3779b97f4a7c15ULL;
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<uint64_t> deposited_values(values.size());
+            core::pdep(values, mask, deposited_values);
+            std::vector<uint64_t> extracted_values(values.size());
+            core::pext(deposited_values, mask, extracted_values);
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                ASSERT_EQ(deposited_values[i], core::pdep(values[i], mask));
+                ASSERT_EQ(extracted_values[i], values[i] & 0xffffffff);
+            }
+        });
+}
+
+TEST(morton_tests, spans__size_mismatch__exception)
+{
+    const std::vector<uint32_t> xs(4), ys(3);
+    std::vector<uint64_t> codes(4);
+    ASSERT_THROW(core::morton_encode_2d(xs, ys, codes), std::length_error);
+    std::vector<uint32_t> small_xs(3), small_ys(3);
+    ASSERT_THROW(core::morton_decode_2d(codes, small_xs, small_ys), std::length_error);
+    ASSERT_THROW(core::pdep(codes, 1, std::span(codes).first(2)), std::length_error);
+}
@@ -0,0 +1,295 @@
+#include "for_each_simd_level.hpp"
+#include <arba/core/bit/varint.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace
+{
+std::vector<uint64_t> make_values(std::size_t count)
+{
+    std::vector<uint64_t> values(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Mostly one-byte values, with runs of longer ones of every size.
+        const uint64_t hash = i * 0x9e3779b97f4a7c15ULL;
+        const unsigned nb_bits = (i / 40) % 3 == 0 ? static_cast<unsigned>(hash >> 58) + 1 : 7;
+        values[i] = nb_bits >= 64 ? hash : (hash >> 7) & ((uint64_t(1) << nb_bits) - 1);
+    }
+    return values;
+}
+
+void check_decode_varints(const std::vector<uint64_t>& values)
+{
+    std::vector<std::byte> bytes(values.size() * core::max_varint_size<uint64_t>);
+    bytes.resize(core::encode_varints<uint64_t>(values, bytes));
+
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<uint64_t> decoded_values(values.size());
+            const core::varints_decode_result result = core::decode_varints(bytes, decoded_values);
+            ASSERT_EQ(result.nb_values, values.size());
+            ASSERT_EQ(result.nb_bytes, bytes.size());
+            ASSERT_EQ(decoded_values, values);
+        });
+}
+} // namespace
+
+TEST(varint_tests, zigzag_encode__values__ok)
+{
+    static_assert(core::zigzag_encode(int32_t(0)) == 0u);
+    static_assert(core::zigzag_encode(int32_t(-1)) == 1u);
+    static_assert(core::zigzag_encode(int32_t(1)) == 2u);
+    static_assert(core::zigzag_encode(int32_t(-2)) == 3u);
+    static_assert(core::zigzag_encode(std::numeric_limits<int64_t>::max()) == std::numeric_limits<uint64_t>::max() - 1);
+    static_assert(core::zigzag_encode(std::numeric_limits<int64_t>::min()) == std::numeric_limits<uint64_t>::max());
+    static_assert(core::zigzag_encode(int8_t(-128)) == uint8_t(255));
+    SUCCEED();
+}
+
+TEST(varint_tests, zigzag_decode__values__ok)
+{
+    for (const int64_t value : { int64_t(0), int64_t(-1), int64_t(1), int64_t(-300), int64_t(123456789),
+                                 std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() })
+        ASSERT_EQ(core::zigzag_decode(core::zigzag_encode(value)), value);
+    static_assert(core::zigzag_decode(uint16_t(3)) == int16_t(-2));
+}
+
+TEST(varint_tests, zigzag_encode__spans__ok)
+{
+    const std::array<int32_t, 5> values{ 0, -1, 1, -2, 1000 };
+    std::array<uint32_t, 5> encoded_values{};
+    core::zigzag_encode<int32_t>(values, encoded_values);
+    ASSERT_EQ(encoded_values, (std::array<uint32_t, 5>{ 0, 1, 2, 3, 2000 }));
+    std::array<int32_t, 5> decoded_values{};
+    core::zigzag_decode<uint32_t>(encoded_values, decoded_values);
+    ASSERT_EQ(decoded_values, values);
+    std::array<uint32_t, 4> too_small_output{};
+    ASSERT_THROW(core::zigzag_encode<int32_t>(values, too_small_output), std::length_error);
+}
+
+TEST(varint_tests, varint_size__values__ok)
+{
+    static_assert(core::max_varint_size<uint8_t> == 2);
+    static_assert(core::max_varint_size<uint32_t> == 5);
+    static_assert(core::max_varint_size<uint64_t> == 10);
+    static_assert(core::varint_size(0u) == 1);
+    static_assert(core::varint_size(127u) == 1);
+    static_assert(core::varint_size(128u) == 2);
+    static_assert(core::varint_size(16383u) == 2);
+    static_assert(core::varint_size(16384u) == 3);
+    static_assert(core::varint_size(std::numeric_limits<uint64_t>::max()) == 10);
+    static_assert(core::varint_size(uint8_t(127)) == 1);
+    static_assert(core::varint_size(uint8_t(200)) == 2);
+    static_assert(core::varint_size(uint16_t(300)) == 2);
+    static_assert(core::varint_size(std::numeric_limits<uint16_t>::max()) == 3);
+    SUCCEED();
+}
+
+TEST(varint_tests, encode_varint__values__ok)
+{
+    std::array<std::byte, 10> bytes{};
+    ASSERT_EQ(core::encode_varint(uint32_t(1), bytes), 1);
+    ASSERT_EQ(bytes[0], std::byte{ 0x01 });
+    ASSERT_EQ(core::encode_varint(uint32_t(300), bytes), 2);
+    ASSERT_EQ(bytes[0], std::byte{ 0xac });
+    ASSERT_EQ(bytes[1], std::byte{ 0x02 });
+    ASSERT_EQ(core::encode_varint(std::numeric_limits<uint64_t>::max(), bytes), 10);
+    ASSERT_EQ(bytes[8], std::byte{ 0xff });
+    ASSERT_EQ(bytes[9], std::byte{ 0x01 });
+}
+
+TEST(varint_tests, encode_varint__maythrow_small_output__exception)
+{
+    std::array<std::byte, 2> bytes{};
+    ASSERT_EQ(core::encode_varint(uint32_t(300), bytes, cppx::maythrow), 2);
+    ASSERT_THROW(core::encode_varint(uint32_t(1u << 14), bytes, cppx::maythrow), std::length_error);
+}
+
+TEST(varint_tests, decode_varint__values__ok)
+{
+    const std::array bytes{ std::byte{ 0xac }, std::byte{ 0x02 }, std::byte{ 0x7f } };
+    const core::varint_decode_result result = core::decode_varint(bytes);
+    ASSERT_EQ(result.value, 300);
+    ASSERT_EQ(result.size, 2);
+    const core::varint_decode_result<uint8_t> small_result = core::decode_varint<uint8_t>(std::span(bytes).subspan(2));
+    ASSERT_EQ(small_result.value, 0x7f);
+    ASSERT_EQ(small_result.size, 1);
+
+    for (const uint64_t value : { uint64_t(0), uint64_t(127), uint64_t(128), uint64_t(1) << 35,
+                                  std::numeric_limits<uint64_t>::max() })
+    {
+        std::array<std::byte, 10> buffer{};
+        const std::size_t size = core::encode_varint(value, buffer);
+        const core::varint_decode_result decoded = core::decode_varint(std::span(buffer).first(size));
+        ASSERT_EQ(decoded.value, value);
+        ASSERT_EQ(decoded.size, size);
+    }
+}
+
+TEST(varint_tests, decode_varint__constexpr__ok)
+{
+    constexpr std::array bytes{ std::byte{ 0xac }, std::byte{ 0x02 } };
+    static_assert(core::decode_varint<uint32_t>(bytes).value == 300);
+    SUCCEED();
+}
+
+TEST(varint_tests, decode_varint__invalid_input__size_0)
+{
+    const std::array truncated_bytes{ std::byte{ 0x80 }, std::byte{ 0x80 } };
+    ASSERT_EQ(core::decode_varint(truncated_bytes).size, 0);
+    ASSERT_EQ(core::decode_varint(std::span<const std::byte>()).size, 0);
+
+    std::array<std::byte, 11> too_long_bytes;
+    too_long_bytes.fill(std::byte{ 0x80 });
+    too_long_bytes.back() = std::byte{ 0x00 };
+    ASSERT_EQ(core::decode_varint(too_long_bytes).size, 0);
+
+    // 2^32 does not fit in uint32_t, 2^64 does not fit in uint64_t.
+    const std::array u32_overflow_bytes{ std::byte{ 0x80 }, std::byte{ 0x80 }, std::byte{ 0x80 }, std::byte{ 0x80 },
+                                         std::byte{ 0x10 } };
+    ASSERT_EQ(core::decode_varint<uint32_t>(u32_overflow_bytes).size, 0);
+    ASSERT_EQ(core::decode_varint<uint64_t>(u32_overflow_bytes).value, uint64_t(1) << 32);
+    std::array<std::byte, 10> u64_overflow_bytes;
+    u64_overflow_bytes.fill(std::byte{ 0xff });
+    u64_overflow_bytes.back() = std::byte{ 0x02 };
+    ASSERT_EQ(core::decode_varint(u64_overflow_bytes).size, 0);
+}
+
+TEST(varint_tests, decode_varint__maythrow_invalid_input__exception)
+{
+    const std::array truncated_bytes{ std::byte{ 0x80 } };
+    ASSERT_THROW(static_cast<void>(core::decode_varint(truncated_bytes, cppx::maythrow)), std::invalid_argument);
+    const std::array bytes{ std::byte{ 0x05 } };
+    ASSERT_EQ(core::decode_varint(bytes, cppx::maythrow).value, 5);
+}
+
+TEST(varint_tests, encode_varints__small_output__exception)
+{
+    const std::array<uint64_t, 3> values{ 1, 300, 2 };
+    std::array<std::byte, 3> bytes{};
+    ASSERT_THROW(static_cast<void>(core::encode_varints<uint64_t>(values, bytes)), std::length_error);
+    std::array<std::byte, 4> exact_bytes{};
+    ASSERT_EQ(core::encode_varints<uint64_t>(values, exact_bytes), 4);
+}
+
+TEST(varint_tests, decode_varints__mixed_values__ok)
+{
+    for (const std::size_t count : { 0, 1, 15, 16, 17, 100, 1000 })
+        check_decode_varints(make_values(count));
+}
+
+TEST(varint_tests, decode_varints__single_byte_values__ok)
+{
+    std::vector<uint64_t> values(333);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = i % 128;
+    check_decode_varints(values);
+}
+
+TEST(varint_tests, decode_varints__long_values__ok)
+{
+    std::vector<uint64_t> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = std::numeric_limits<uint64_t>::max() - i;
+    check_decode_varints(values);
+}
+
+TEST(varint_tests, decode_varints__one_multi_byte_value_per_run__ok)
+{
+    // A multi-byte value at every offset of runs of one-byte values, so in every position of the SIMD chunks.
+    for (std::size_t run_size = 1; run_size <= 18; ++run_size)
+    {
+        std::vector<uint64_t> values(200);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = i % run_size == run_size - 1 ? (uint64_t(1) << (7 * (i % 9 + 1))) + i : i % 128;
+        check_decode_varints(values);
+    }
+}
+
+TEST(varint_tests, decode_varints__two_byte_values__ok)
+{
+    std::vector<uint64_t> values(150);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = 128 + i * 97;
+    check_decode_varints(values);
+}
+
+TEST(varint_tests, decode_varints__several_multi_byte_values_per_chunk__ok)
+{
+    // Sizes cycling from 1 to 10 bytes, then from 1 to 3 bytes, so that chunks hold several multi-byte values of
+    // every size, and that varints cross the chunk ends at every offset.
+    for (const std::size_t max_size : { std::size_t(10), std::size_t(3) })
+    {
+        std::vector<uint64_t> values(300);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            const std::size_t size = i % max_size + 1;
+            values[i] = size == 10 ? std::numeric_limits<uint64_t>::max() - i : (uint64_t(1) << (7 * size - 1)) + i;
+        }
+        check_decode_varints(values);
+    }
+}
+
+TEST(varint_tests, decode_varints__small_output__stops)
+{
+    const std::vector<uint64_t> values = make_values(100);
+    std::vector<std::byte> bytes(values.size() * core::max_varint_size<uint64_t>);
+    bytes.resize(core::encode_varints<uint64_t>(values, bytes));
+    std::vector<uint64_t> decoded_values(40);
+    const core::varints_decode_result result = core::decode_varints(bytes, decoded_values);
+    ASSERT_EQ(result.nb_values, 40);
+    ASSERT_EQ(decoded_values, std::vector<uint64_t>(values.begin(), values.begin() + 40));
+    ASSERT_EQ(core::decode_varints(std::span(bytes).subspan(result.nb_bytes), decoded_values).nb_values, 40);
+    ASSERT_EQ(decoded_values, std::vector<uint64_t>(values.begin() + 40, values.begin() + 80));
+}
+
+TEST(varint_tests, decode_varints__malformed_input__stops)
+{
+    std::vector<std::byte> bytes(40, std::byte{ 0x01 });
+    for (std::size_t i = 20; i < 31; ++i)
+        bytes[i] = std::byte{ 0x80 };
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<uint64_t> values(40);
+            const core::varints_decode_result result = core::decode_varints(bytes, values);
+            ASSERT_EQ(result.nb_values, 20);
+            ASSERT_EQ(result.nb_bytes, 20);
+        });
+}
+
+TEST(varint_tests, decode_varints__malformed_input_after_multi_byte_values__stops)
+{
+    std::vector<std::byte> bytes(60, std::byte{ 0x01 });
+    for (std::size_t i = 0; i < 20; i += 2)
+        bytes[i] = std::byte{ 0x81 };
+    for (std::size_t i = 20; i < 31; ++i)
+        bytes[i] = std::byte{ 0x80 };
+    ut::for_each_simd_level(
+        [&]
+        {
+            std::vector<uint64_t> values(60);
+            const core::varints_decode_result result = core::decode_varints(bytes, values);
+            ASSERT_EQ(result.nb_values, 10);
+            ASSERT_EQ(result.nb_bytes, 20);
+            ASSERT_EQ(values[9], 0x81);
+        });
+}
+
+TEST(varint_tests, decode_varints__truncated_input__stops)
+{
+    const std::vector<uint64_t> values = make_values(50);
+    std::vector<std::byte> bytes(values.size() * core::max_varint_size<uint64_t>);
+    bytes.resize(core::encode_varints<uint64_t>(values, bytes));
+    bytes.push_back(std::byte{ 0x81 });
+    std::vector<uint64_t> decoded_values(60);
+    const core::varints_decode_result result = core::decode_varints(bytes, decoded_values);
+    ASSERT_EQ(result.nb_values, 50);
+    ASSERT_EQ(result.nb_bytes, bytes.size() - 1);
+}
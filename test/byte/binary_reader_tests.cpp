@@ -0,0 +1,84 @@
+#include <arba/core/byte/binary_reader.hpp>
+#include <arba/core/byte/binary_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+std::vector<std::byte> to_bytes(std::initializer_list<uint8_t> values)
+{
+    std::vector<std::byte> bytes;
+    for (uint8_t value : values)
+        bytes.push_back(static_cast<std::byte>(value));
+    return bytes;
+}
+} // namespace
+
+TEST(binary_reader_tests, read__big_endian__ok)
+{
+    const std::vector<std::byte> bytes = to_bytes({ 0x11, 0x22, 0x33, 0x44, 0xff, 0xfe, 0x7a, 0x3f, 0x80, 0x00, 0x00 });
+    core::binary_reader reader(bytes);
+    ASSERT_EQ(reader.read<uint32_t>(), 0x11223344u);
+    ASSERT_EQ(reader.read<int16_t>(), -2);
+    ASSERT_EQ(reader.read<std::byte>(), std::byte(0x7a));
+    ASSERT_EQ(reader.read<float>(), 1.0f);
+    ASSERT_TRUE(reader.empty());
+    ASSERT_THROW((void)reader.read<uint8_t>(cppx::maythrow), std::out_of_range);
+}
+
+TEST(binary_reader_tests, read__little_endian_after_require__ok)
+{
+    const std::vector<std::byte> bytes = to_bytes({ 0x22, 0x11, 0x66, 0x55, 0x44, 0x33, 0x01 });
+    core::binary_reader<std::endian::little> reader(bytes);
+    reader.require(6);
+    ASSERT_EQ(reader.read<uint16_t>(), 0x1122);
+    ASSERT_EQ(reader.read<uint32_t>(), 0x33445566u);
+    ASSERT_EQ(reader.remaining_size(), 1);
+    ASSERT_THROW(reader.require(2), std::out_of_range);
+}
+
+TEST(binary_reader_tests, read__span_of_values__ok)
+{
+    const std::vector<std::byte> bytes = to_bytes({ 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0xaa, 0xbb, 0xcc });
+    core::binary_reader reader(bytes);
+    std::vector<uint16_t> values(3);
+    reader.read(std::span(values));
+    ASSERT_EQ(values, (std::vector<uint16_t>{ 1, 2, 3 }));
+    std::span<const std::byte> tail = reader.read_bytes(2);
+    ASSERT_EQ(tail.data(), bytes.data() + 6);
+    ASSERT_THROW(reader.read(std::span(values), cppx::maythrow), std::out_of_range);
+    ASSERT_EQ(reader.position(), 8);
+}
+
+TEST(binary_reader_tests, seek_skip__ok)
+{
+    const std::vector<std::byte> bytes = to_bytes({ 0x00, 0x01, 0x02, 0x03 });
+    core::binary_reader reader(bytes);
+    reader.skip(2);
+    ASSERT_EQ(reader.read<uint8_t>(), 2);
+    reader.seek(0);
+    ASSERT_EQ(reader.read<uint16_t>(), 1);
+    ASSERT_THROW(reader.seek(5, cppx::maythrow), std::out_of_range);
+    ASSERT_THROW(reader.skip(3, cppx::maythrow), std::out_of_range);
+}
+
+TEST(binary_reader_tests, round_trip__ok)
+{
+    std::vector<double> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<double>(i) * 0.5 - 12.0;
+    std::vector<std::byte> buffer;
+    {
+        core::binary_writer writer(buffer);
+        writer.write(uint32_t(values.size()), cppx::maythrow);
+        writer.write(std::span(values), cppx::maythrow);
+    }
+    core::binary_reader reader(buffer);
+    std::vector<double> read_values(reader.read<uint32_t>());
+    reader.read(std::span(read_values));
+    ASSERT_EQ(read_values, values);
+    ASSERT_TRUE(reader.empty());
+}
@@ -0,0 +1,80 @@
+#include <arba/core/byte/binary_writer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+std::vector<std::byte> to_bytes(std::initializer_list<uint8_t> values)
+{
+    std::vector<std::byte> bytes;
+    for (uint8_t value : values)
+        bytes.push_back(static_cast<std::byte>(value));
+    return bytes;
+}
+} // namespace
+
+TEST(binary_writer_tests, write__vector_big_endian__ok)
+{
+    std::vector<std::byte> buffer = to_bytes({ 0xff });
+    {
+        core::binary_writer writer(buffer);
+        ASSERT_EQ(writer.position(), 1);
+        writer.write(uint32_t(0x11223344), cppx::maythrow);
+        writer.write(int16_t(-2), cppx::maythrow);
+        writer.write(std::byte(0x7a), cppx::maythrow);
+        writer.write(1.0f, cppx::maythrow);
+        ASSERT_EQ(writer.position(), 12);
+    }
+    ASSERT_EQ(buffer, to_bytes({ 0xff, 0x11, 0x22, 0x33, 0x44, 0xff, 0xfe, 0x7a, 0x3f, 0x80, 0x00, 0x00 }));
+}
+
+TEST(binary_writer_tests, write__span_little_endian__ok)
+{
+    std::array<std::byte, 6> buffer{};
+    core::binary_writer<std::endian::little> writer(buffer);
+    writer.write(uint16_t(0x1122));
+    writer.write(uint32_t(0x33445566));
+    ASSERT_EQ(writer.remaining_capacity(), 0);
+    ASSERT_TRUE(std::ranges::equal(writer.written_bytes(), to_bytes({ 0x22, 0x11, 0x66, 0x55, 0x44, 0x33 })));
+    ASSERT_THROW(writer.write(uint8_t(0), cppx::maythrow), std::length_error);
+}
+
+TEST(binary_writer_tests, write__reserve_then_unchecked__ok)
+{
+    std::vector<std::byte> buffer;
+    {
+        core::binary_writer writer(buffer);
+        for (uint16_t i = 0; i < 1000; ++i)
+        {
+            writer.reserve(sizeof(uint16_t) + sizeof(uint8_t));
+            writer.write(i);
+            writer.write(uint8_t(i));
+        }
+    }
+    ASSERT_EQ(buffer.size(), 3000);
+    ASSERT_EQ(buffer[3 * 999], std::byte(0x03));
+    ASSERT_EQ(buffer[3 * 999 + 1], std::byte(0xe7));
+    ASSERT_EQ(buffer[3 * 999 + 2], std::byte(0xe7));
+}
+
+TEST(binary_writer_tests, write__span_of_values__ok)
+{
+    const std::vector<uint32_t> values = { 0x01020304, 0x05060708, 0x090a0b0c };
+    const std::array<uint8_t, 2> tag = { 0xaa, 0xbb };
+    std::vector<std::byte> buffer;
+    {
+        core::binary_writer writer(buffer);
+        writer.write(std::span(values), cppx::maythrow);
+        writer.write(std::span(tag), cppx::maythrow);
+    }
+    ASSERT_EQ(buffer, to_bytes({ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0xaa, 0xbb }));
+
+    std::array<std::byte, 8> small_buffer{};
+    core::binary_writer small_writer(small_buffer);
+    ASSERT_THROW(small_writer.write(std::span(values), cppx::maythrow), std::length_error);
+    ASSERT_EQ(small_writer.position(), 0);
+}
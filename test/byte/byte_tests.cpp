@@ -32,6 +32,13 @@ TEST(byte_tests, std_formatter_byte__format_x__ok)
     ASSERT_EQ(value, "ff");
 }
 
+TEST(byte_tests, std_formatter_byte__format_upper_x__ok)
+{
+    const std::byte byte{ 0xab };
+    ASSERT_EQ(std::format("{:X}", byte), "AB");
+    ASSERT_EQ(std::format("{:0X}", byte), "0XAB");
+}
+
 TEST(byte_tests, std_formatter_byte__format_b__ok)
 {
     const std::byte byte{ 0b1010'1010 };
@@ -101,3 +108,33 @@ TEST(byte_tests, std_formatter_byte__bad_format__err)
         SUCCEED();
     }
 }
+
+TEST(byte_tests, std_formatter_byte__all_values__ok)
+{
+    for (unsigned value = 0; value < 256; ++value)
+    {
+        const std::byte byte{ static_cast<uint8_t>(value) };
+        const int signed_value = static_cast<int8_t>(value);
+        ASSERT_EQ(std::format("{:u}", byte), std::format("{}", value));
+        ASSERT_EQ(std::format("{:i}", byte), std::format("{}", signed_value));
+        ASSERT_EQ(std::format("{:x}", byte), std::format("{:02x}", value));
+        ASSERT_EQ(std::format("{:b}", byte), std::format("{:08b}", value));
+        ASSERT_EQ(std::format("{:0u}", byte), std::format("{:03d}", value));
+        ASSERT_EQ(std::format("{:0i}", byte), std::format("{:04d}", signed_value));
+        ASSERT_EQ(std::format("{:0o}", byte), std::format("0o{:03o}", value));
+    }
+}
+
+TEST(byte_tests, std_formatter_byte__format_0i_positive__ok)
+{
+    ASSERT_EQ(std::format("{:0i}", std::byte{ 5 }), "0005");
+    ASSERT_EQ(std::format("{:0i}", std::byte{ 127 }), "0127");
+    ASSERT_EQ(std::format("{:0i}", std::byte{ 128 }), "-128");
+}
+
+TEST(byte_tests, std_formatter_byte__bad_format_0c__err)
+{
+    const std::byte byte{ 255 };
+    ASSERT_THROW(std::ignore = std::vformat("{:0c}", std::make_format_args(byte)), std::format_error);
+    ASSERT_THROW(std::ignore = std::vformat("{:xx}", std::make_format_args(byte)), std::format_error);
+}
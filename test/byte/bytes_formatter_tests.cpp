@@ -1,4 +1,5 @@
 #include "create_resource.hpp"
+#include "for_each_simd_level.hpp"
 #include <arba/core/byte/bytes_formatter.hpp>
 
 #include <gtest/gtest.h>
@@ -95,3 +96,425 @@ TEST_F(bytes_formatter_tests, format_binary_cstream__valid_fcstream__ok)
     ASSERT_EQ(result, expected_res);
     std::fclose(input_file);
 }
+
+TEST_F(bytes_formatter_tests, format_bytes__unit_formats__same_as_vformat)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    std::vector<std::byte> bytes(300);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 7);
+    for (const std::string_view format : { "{}", "{:0x}", "{:i}", "{0:0i}|{1}", "<{1:>6x}>{{{0:b}}}", "{}:{}", "{:c}" })
+    {
+        core::bytes_formatter bformatter(unit_format(std::string(format)), unit_sep(" "), seq_beginning(""),
+                                         seq_end(""), nb_units_per_chunk(1000));
+        std::string expected_res;
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            if (i > 0)
+                expected_res += ' ';
+            const std::size_t unit_index = i + 3;
+            expected_res += std::vformat(format, std::make_format_args(bytes[i], unit_index));
+        }
+        ASSERT_EQ(bformatter.format_bytes(bytes, 3), expected_res) << format;
+    }
+}
+
+TEST_F(bytes_formatter_tests, format_bytes__large_span__ok)
+{
+    std::vector<std::byte> bytes(200'000);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i % 251);
+    core::bytes_formatter bformatter;
+    const std::string result = bformatter.format_bytes(bytes);
+    std::string expected_res = "[";
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+    {
+        expected_res += std::format("{:x}", bytes[i]);
+        if ((i + 1) % 32 == 0)
+            expected_res += "\n";
+        else if (i + 1 < bytes.size())
+            expected_res += ", ";
+    }
+    expected_res += "]";
+    ASSERT_EQ(result, expected_res);
+}
+
+TEST_F(bytes_formatter_tests, bytes_formatter__invalid_unit_format__exception)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    for (const std::string_view format : { "{:z}", "{2}", "{0}{}", "{", "x}", "{1:q}", "{:0c}" })
+        ASSERT_THROW(core::bytes_formatter{ unit_format(std::string(format)) }, std::format_error) << format;
+    core::bytes_formatter bformatter;
+    ASSERT_THROW(bformatter.set_unit_format("{:{}}"), std::format_error);
+    ASSERT_EQ(bformatter.unit_format(), "{:x}");
+}
+
+TEST_F(bytes_formatter_tests, format_bytes_to__string_and_vector__appended)
+{
+    const std::vector<std::uint8_t> bytes = { 1, 2, 254, 255 };
+    core::bytes_formatter bformatter;
+    std::string text = "bytes: ";
+    bformatter.format_bytes_to(std::as_bytes(std::span(bytes)), text);
+    ASSERT_EQ(text, "bytes: [01, 02, fe, ff]");
+    std::vector<char> chars = { '>' };
+    bformatter.format_bytes_to(std::as_bytes(std::span(bytes)), chars, 10);
+    ASSERT_EQ(std::string_view(chars.data(), chars.size()), ">[01, 02, fe, ff]");
+}
+
+TEST_F(bytes_formatter_tests, format_bytes_to__output_iterator__ok)
+{
+    const std::vector<std::uint8_t> bytes = { 1, 2, 254, 255 };
+    core::bytes_formatter bformatter;
+    std::array<char, 32> chars{};
+    char* end = bformatter.format_bytes_to(std::as_bytes(std::span(bytes)), chars.data());
+    ASSERT_EQ(std::string_view(chars.data(), end), "[01, 02, fe, ff]");
+    std::string text;
+    bformatter.format_bytes_to(std::as_bytes(std::span(bytes)), std::back_inserter(text));
+    ASSERT_EQ(text, "[01, 02, fe, ff]");
+}
+
+TEST_F(bytes_formatter_tests, format_binary_stream_to__file_and_fd__ok)
+{
+    core::bytes_formatter bformatter;
+    std::string_view expected_res = "[00, 02, 04, 07, 0b, 0d, 11, 17, 42, 0c, 0e, 12, 19, 21, 7f, 41]";
+    FILE* output_file = std::tmpfile();
+    ASSERT_NE(output_file, nullptr);
+    std::ifstream input_file_stream(input_fpath, std::ios::binary);
+    bformatter.format_binary_stream_to(input_file_stream, output_file);
+#if defined(ARBA_CORE_HAS_POSIX_IO)
+    std::fflush(output_file);
+    const std::vector<std::byte> bytes(3, std::byte{ 0xaa });
+    bformatter.format_bytes_to(bytes, core::fd_output{ fileno(output_file) });
+    std::fseek(output_file, 0, SEEK_SET);
+    const std::string expected_text = std::string(expected_res) + "[aa, aa, aa]";
+#else
+    std::fseek(output_file, 0, SEEK_SET);
+    const std::string expected_text(expected_res);
+#endif
+    std::string text(expected_text.size() + 1, '\0');
+    text.resize(std::fread(text.data(), 1, text.size(), output_file));
+    ASSERT_EQ(text, expected_text);
+    std::fclose(output_file);
+}
+
+TEST_F(bytes_formatter_tests, format_bytes_to__span_output__resumable)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    std::vector<std::byte> bytes(100);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 3);
+    core::bytes_formatter bformatter(unit_format("{1}:{0:0x}"), chunk_beginning("("), chunk_end(")"),
+                                     nb_units_per_chunk(7));
+    const std::string expected_res = bformatter.format_bytes(bytes, 5);
+    for (const std::size_t output_size : { 1, 5, 64, 4096 })
+    {
+        std::vector<char> output(output_size);
+        core::bytes_formatter::span_output_state state(5);
+        std::string text;
+        while (!state.done())
+        {
+            const std::size_t nb_written = bformatter.format_bytes_to(bytes, output, state);
+            ASSERT_GT(nb_written, 0);
+            text.append(output.data(), nb_written);
+        }
+        ASSERT_EQ(text, expected_res) << output_size;
+        ASSERT_EQ(state.nb_formatted_bytes(), bytes.size());
+        ASSERT_EQ(bformatter.format_bytes_to(bytes, output, state), 0);
+    }
+    core::bytes_formatter::span_output_state state;
+    std::array<char, 8> output;
+    ASSERT_EQ(bformatter.format_bytes_to(std::span<const std::byte>(), output, state), 2);
+    ASSERT_TRUE(state.done());
+    ASSERT_EQ(std::string_view(output.data(), 2), "[]");
+}
+
+TEST_F(bytes_formatter_tests, format_bytes__digit_units__same_as_generic_format)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    std::vector<std::byte> bytes(300);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 37 + 11);
+    const std::array<std::array<std::string_view, 2>, 9> layouts = { {
+        { "{:x}", ", " },
+        { "{:x}", "" },
+        { "{:X}", " " },
+        { "{:0x}", ", " },
+        { "{:0X}", "::::" },
+        { "{:x}", "<sep>|" },
+        { "{:b}", "" },
+        { "{:0b}", ", " },
+        { "{:0x}", "<long separator>" },
+    } };
+    for (const auto& [format, separator] : layouts)
+    {
+        for (const std::size_t nb_bytes : { 0, 1, 15, 16, 17, 31, 32, 33, 100, 300 })
+        {
+            for (const uint32_t chunk_size : { 1u, 7u, 32u, 1000u })
+            {
+                const std::span<const std::byte> input = std::span(bytes).first(nb_bytes);
+                std::string expected_res = "<";
+                for (std::size_t i = 0; i < nb_bytes; ++i)
+                {
+                    expected_res += std::vformat(format, std::make_format_args(bytes[i]));
+                    if ((i + 1) % chunk_size == 0)
+                        expected_res += "|\n";
+                    else if (i + 1 < nb_bytes)
+                        expected_res += separator;
+                }
+                expected_res += ">";
+                core::bytes_formatter bformatter(unit_format(std::string(format)), unit_sep(std::string(separator)),
+                                                 seq_beginning("<"), seq_end(">"), chunk_end("|\n"),
+                                                 nb_units_per_chunk(chunk_size));
+                ut::for_each_simd_level(
+                    [&]
+                    {
+                        ASSERT_EQ(bformatter.format_bytes(input), expected_res)
+                            << format << " '" << separator << "' " << nb_bytes << ' ' << chunk_size;
+                    });
+            }
+        }
+    }
+}
+
+TEST_F(bytes_formatter_tests, format_bytes__parallel__same_as_sequential)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    std::vector<std::byte> bytes(800'000);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 7 + i / 1000);
+    for (const std::string_view format : { "{:x}", "{1}:{0:0u}" })
+    {
+        for (const uint32_t chunk_size : { 1u, 32u, 1000u, 1'000'000u })
+        {
+            for (const std::size_t nb_bytes : { std::size_t(300'000), bytes.size() - 1 })
+            {
+                const std::span<const std::byte> input = std::span(bytes).first(nb_bytes);
+                core::bytes_formatter bformatter{ unit_format(std::string(format)), nb_units_per_chunk(chunk_size) };
+                const std::string expected_res = bformatter.format_bytes(input, 5);
+                for (const uint32_t nb_threads : { 0u, 2u, 3u, 8u })
+                {
+                    bformatter.set_nb_threads(nb_threads);
+                    ASSERT_EQ(bformatter.format_bytes(input, 5), expected_res)
+                        << format << ' ' << chunk_size << ' ' << nb_bytes << ' ' << nb_threads;
+                }
+            }
+        }
+    }
+}
+
+namespace
+{
+// Output iterator failing after a given number of chars.
+class failing_output_iterator
+{
+public:
+    using difference_type = std::ptrdiff_t;
+
+    explicit failing_output_iterator(std::size_t nb_chars_before_failure = 0)
+        : nb_chars_before_failure_(nb_chars_before_failure)
+    {
+    }
+
+    failing_output_iterator& operator*() { return *this; }
+    failing_output_iterator& operator=(char)
+    {
+        if (nb_chars_before_failure_-- == 0)
+            throw std::runtime_error("Output failure.");
+        return *this;
+    }
+    failing_output_iterator& operator++() { return *this; }
+    failing_output_iterator operator++(int) { return *this; }
+
+private:
+    std::size_t nb_chars_before_failure_;
+};
+} // namespace
+
+TEST_F(bytes_formatter_tests, format_bytes_to__parallel_output_failure__exception)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const std::vector<std::byte> bytes(5'000'000, std::byte{ 0x42 });
+    const core::bytes_formatter bformatter(nb_threads(4));
+    for (const std::size_t nb_chars_before_failure : { std::size_t(0), std::size_t(3'000'000) })
+        ASSERT_THROW(bformatter.format_bytes_to(bytes, failing_output_iterator(nb_chars_before_failure)),
+                     std::runtime_error);
+}
+
+TEST_F(bytes_formatter_tests, format_binary_file__valid_file__ok)
+{
+    core::bytes_formatter bformatter;
+    ASSERT_EQ(bformatter.format_binary_file(input_fpath),
+              "[00, 02, 04, 07, 0b, 0d, 11, 17, 42, 0c, 0e, 12, 19, 21, 7f, 41]");
+    ASSERT_EQ(bformatter.format_binary_file(input_fpath, 14), "[7f, 41]");
+    ASSERT_EQ(bformatter.format_binary_file(input_fpath, 3, 2), "[07, 0b]");
+    ASSERT_EQ(bformatter.format_binary_file(input_fpath, 16), "[]");
+    std::ostringstream stream;
+    bformatter.format_binary_file_to(input_fpath, stream, 8, 1);
+    ASSERT_EQ(stream.str(), "[42]");
+}
+
+TEST_F(bytes_formatter_tests, format_binary_file__large_file_window__ok)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    std::vector<std::byte> bytes(100'000);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 13 + i / 256);
+    const std::filesystem::path file_path = input_fpath.parent_path() / "large_resource.bin";
+    {
+        std::ofstream file_stream(file_path, std::ios::binary | std::ios::trunc);
+        file_stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    const core::bytes_formatter bformatter(unit_format("{1:x}:{0}"), nb_units_per_chunk(16));
+    ASSERT_EQ(bformatter.format_binary_file(file_path, 5000, 70'000),
+              bformatter.format_bytes(std::span(bytes).subspan(5000, 70'000), 5000));
+    ASSERT_EQ(bformatter.format_binary_file(file_path, 99'990, 1000),
+              bformatter.format_bytes(std::span(bytes).subspan(99'990), 99'990));
+    std::filesystem::remove(file_path);
+}
+
+TEST_F(bytes_formatter_tests, format_binary_file__invalid_file__exception)
+{
+    core::bytes_formatter bformatter;
+    ASSERT_THROW(std::ignore = bformatter.format_binary_file(input_fpath.parent_path() / "missing.bin"),
+                 std::system_error);
+    ASSERT_THROW(std::ignore = bformatter.format_binary_file(input_fpath, 17), std::out_of_range);
+}
+
+namespace
+{
+// Non-seekable input of generated bytes, optionally failing after them.
+class generator_streambuf : public std::streambuf
+{
+public:
+    generator_streambuf(std::size_t nb_bytes, bool fails) : nb_remaining_bytes_(nb_bytes), fails_(fails) {}
+
+    static std::byte byte_at(std::size_t index) { return static_cast<std::byte>(index * 29 + index / 300); }
+
+protected:
+    int_type underflow() override
+    {
+        if (nb_remaining_bytes_ == 0)
+        {
+            if (fails_)
+                throw std::runtime_error("Input failure.");
+            return traits_type::eof();
+        }
+        const std::size_t nb_bytes = std::min(nb_remaining_bytes_, buffer_.size());
+        for (std::size_t i = 0; i < nb_bytes; ++i)
+            buffer_[i] = static_cast<char>(byte_at(nb_generated_bytes_ + i));
+        nb_generated_bytes_ += nb_bytes;
+        nb_remaining_bytes_ -= nb_bytes;
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + nb_bytes);
+        return traits_type::to_int_type(buffer_[0]);
+    }
+
+private:
+    std::array<char, 1000> buffer_;
+    std::size_t nb_generated_bytes_ = 0;
+    std::size_t nb_remaining_bytes_;
+    bool fails_;
+};
+} // namespace
+
+TEST_F(bytes_formatter_tests, format_binary_stream__non_seekable_stream__ok)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const core::bytes_formatter bformatter(unit_format("{:0x}"), chunk_beginning("("), chunk_end(")"));
+    for (const std::size_t nb_bytes : { 0, 1, 65'535, 65'536, 65'537, 2 * 65'536, 300'000 })
+    {
+        std::vector<std::byte> bytes(nb_bytes);
+        for (std::size_t i = 0; i < nb_bytes; ++i)
+            bytes[i] = generator_streambuf::byte_at(i);
+        generator_streambuf streambuf(nb_bytes, false);
+        std::istream input_stream(&streambuf);
+        ASSERT_EQ(bformatter.format_binary_stream(input_stream, 7), bformatter.format_bytes(bytes, 7)) << nb_bytes;
+    }
+}
+
+TEST_F(bytes_formatter_tests, format_binary_stream__failing_stream__exception)
+{
+    const core::bytes_formatter bformatter;
+    for (const std::size_t nb_bytes : { 10, 200'000 })
+    {
+        generator_streambuf streambuf(nb_bytes, true);
+        std::istream input_stream(&streambuf);
+        ASSERT_THROW(std::ignore = bformatter.format_binary_stream(input_stream), std::ios_base::failure);
+    }
+}
+
+TEST_F(bytes_formatter_tests, format_binary_cstream__block_sized_files__ok)
+{
+    const core::bytes_formatter bformatter;
+    for (const std::size_t nb_bytes : { 0, 65'536, 3 * 65'536 + 5 })
+    {
+        std::vector<std::byte> bytes(nb_bytes);
+        for (std::size_t i = 0; i < nb_bytes; ++i)
+            bytes[i] = generator_streambuf::byte_at(i);
+        FILE* file = std::tmpfile();
+        ASSERT_NE(file, nullptr);
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::rewind(file);
+        ASSERT_EQ(bformatter.format_binary_cstream(file), bformatter.format_bytes(bytes)) << nb_bytes;
+        std::fclose(file);
+    }
+}
+
+TEST_F(bytes_formatter_tests, format_binary_stream_to__output_failure__exception)
+{
+    const core::bytes_formatter bformatter;
+    // In the first block, possibly before the next one is read, and in a later block.
+    for (const std::size_t nb_chars : { 10, 500'000 })
+    {
+        generator_streambuf streambuf(1'000'000, false);
+        std::istream input_stream(&streambuf);
+        ASSERT_THROW(bformatter.format_binary_stream_to(input_stream, failing_output_iterator(nb_chars)),
+                     std::runtime_error)
+            << nb_chars;
+    }
+}
+
+TEST_F(bytes_formatter_tests, session__fragments__same_as_whole_input)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    std::vector<std::byte> bytes(1000);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 11);
+    const core::bytes_formatter bformatter(unit_format("{1}:{0:x}"), chunk_beginning("("), chunk_end(")"),
+                                           nb_units_per_chunk(10));
+    core::bytes_formatter::session session(bformatter, 3);
+    for (const std::size_t fragment_size : { 1, 7, 10, 64, 999, 1000 })
+    {
+        std::string text;
+        for (std::size_t i = 0; i < bytes.size(); i += fragment_size)
+        {
+            text += session.feed(std::span(bytes).subspan(i, std::min(fragment_size, bytes.size() - i)));
+            text += session.feed({});
+        }
+        ASSERT_FALSE(session.is_finished());
+        text += session.finish();
+        ASSERT_TRUE(session.is_finished());
+        ASSERT_EQ(session.nb_received_bytes(), bytes.size());
+        ASSERT_EQ(text, bformatter.format_bytes(bytes, 3)) << fragment_size;
+        session.reset(3);
+    }
+}
+
+TEST_F(bytes_formatter_tests, session__empty_input__ok)
+{
+    const core::bytes_formatter bformatter;
+    core::bytes_formatter::session session(bformatter);
+    std::string text(session.feed({}));
+    text += session.finish();
+    ASSERT_EQ(text, "[]");
+    ASSERT_THROW(std::ignore = session.feed({}), std::logic_error);
+    ASSERT_THROW(std::ignore = session.finish(), std::logic_error);
+}
@@ -0,0 +1,209 @@
+#include "for_each_simd_level.hpp"
+#include <arba/core/byte/bytes_parser.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <span>
+#include <sstream>
+
+namespace
+{
+std::vector<std::byte> make_bytes(std::size_t nb_bytes)
+{
+    std::vector<std::byte> bytes(nb_bytes);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::byte>(i * 37 + 11 + i / 256);
+    return bytes;
+}
+} // namespace
+
+TEST(bytes_parser_tests, parse__default_format__ok)
+{
+    core::bytes_parser bparser;
+    ASSERT_EQ(bparser.parse("[]"), std::vector<std::byte>{});
+    const std::vector<std::byte> expected_res = { std::byte(0x0a), std::byte(0xff), std::byte(0x00) };
+    ASSERT_EQ(bparser.parse("[0a, ff, 00]"), expected_res);
+}
+
+TEST(bytes_parser_tests, parse__formatted_bytes__same_bytes)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const std::vector<std::byte> bytes = make_bytes(5000);
+    const std::array<std::array<std::string_view, 2>, 15> layouts = { {
+        { "{:x}", ", " },
+        { "{:x}", "" },
+        { "{:X}", " " },
+        { "{:0x}", ", " },
+        { "{:0X}", "::::" },
+        { "{:0x}", "<long separator>" },
+        { "{:b}", "" },
+        { "{}", "," },
+        { "{:i}", " " },
+        { "{:0i}", "" },
+        { "{:o}", "" },
+        { "{:c}", "" },
+        { "{1}:{0:0u}", "," },
+        { "{0:x}({0:u})", " " },
+        { "{1:>6x}={0:x}", "," },
+    } };
+    for (const auto& [format, separator] : layouts)
+    {
+        for (const std::size_t nb_bytes : { 0, 1, 15, 16, 17, 33, 100, 1000, 5000 })
+        {
+            for (const uint32_t chunk_size : { 1u, 7u, 32u, 1000u })
+            {
+                for (const bool force_end : { false, true })
+                {
+                    const core::bytes_formatter bformatter{ unit_format(std::string(format)),
+                                                            unit_sep(std::string(separator)),
+                                                            seq_beginning("<"),
+                                                            seq_end(">"),
+                                                            chunk_beginning("{"),
+                                                            chunk_end("}\n"),
+                                                            nb_units_per_chunk(chunk_size),
+                                                            force_chunk_end(force_end) };
+                    const core::bytes_parser bparser(bformatter);
+                    const std::span<const std::byte> input = std::span(bytes).first(nb_bytes);
+                    const std::string text = bformatter.format_bytes(input, 42);
+                    ut::for_each_simd_level(
+                        [&]
+                        {
+                            ASSERT_TRUE(std::ranges::equal(bparser.parse(text, 42), input))
+                                << format << " '" << separator << "' " << nb_bytes << ' ' << chunk_size << ' '
+                                << force_end;
+                        });
+                }
+            }
+        }
+    }
+}
+
+TEST(bytes_parser_tests, parse__adjacent_decimal_fields__ok)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const std::vector<std::byte> bytes = { std::byte(25), std::byte(255), std::byte(2), std::byte(5) };
+    const core::bytes_formatter bformatter{ unit_format("{}{}"), unit_sep("|") };
+    const std::string text = bformatter.format_bytes(bytes, 5);
+    ASSERT_EQ(text, "[255|2556|27|58]");
+    ASSERT_EQ(core::bytes_parser(bformatter).parse(text, 5), bytes);
+}
+
+TEST(bytes_parser_tests, parse__invalid_text__exception)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const core::bytes_parser bparser;
+    const std::array<std::pair<std::string_view, std::size_t>, 8> invalid_texts = { {
+        { "", 0 },
+        { "0a]", 0 },
+        { "[0a, 0b", 7 },
+        { "[0a, 0g]", 5 },
+        { "[0a, 0B]", 5 },
+        { "[0a; 0b]", 3 },
+        { "[0a, 0b]\n", 7 },
+        { "[0a, ]", 5 },
+    } };
+    for (const auto& [text, position] : invalid_texts)
+    {
+        try
+        {
+            std::ignore = bparser.parse(text);
+            FAIL() << text;
+        }
+        catch (const core::bytes_parse_error& error)
+        {
+            ASSERT_EQ(error.position(), position) << text;
+        }
+    }
+
+    const core::bytes_parser indexed_bparser(unit_format("{1}:{0}"));
+    ASSERT_EQ(indexed_bparser.parse("[0:1, 1:2]"), (std::vector<std::byte>{ std::byte(1), std::byte(2) }));
+    ASSERT_THROW(std::ignore = indexed_bparser.parse("[0:1, 2:2]"), core::bytes_parse_error);
+    const core::bytes_parser padded_indexed_bparser(unit_format("{1:02}:{0}"));
+    ASSERT_EQ(padded_indexed_bparser.parse("[00:1, 01:2]"), (std::vector<std::byte>{ std::byte(1), std::byte(2) }));
+    ASSERT_THROW(std::ignore = padded_indexed_bparser.parse("[00:1, 1:2]"), core::bytes_parse_error);
+    ASSERT_THROW(std::ignore = padded_indexed_bparser.parse("[00:1, 0"), core::bytes_parse_error);
+    ASSERT_THROW(std::ignore = core::bytes_parser(unit_format("{0:x}{0:x}")).parse("[0a0b]"), core::bytes_parse_error);
+    ASSERT_THROW(std::ignore = core::bytes_parser(unit_format("{}")).parse("[256]"), core::bytes_parse_error);
+    ASSERT_THROW(std::ignore = core::bytes_parser(unit_format("{}")).parse("[007]"), core::bytes_parse_error);
+}
+
+TEST(bytes_parser_tests, parse__invalid_hex_digit_in_long_text__exception)
+{
+    const std::vector<std::byte> bytes = make_bytes(10'000);
+    const core::bytes_formatter bformatter;
+    std::string text = bformatter.format_bytes(bytes);
+    const std::size_t unit_position = text.find(", ", text.size() / 2) + 2;
+    text[unit_position + 1] = 'G';
+    ut::for_each_simd_level(
+        [&]
+        {
+            try
+            {
+                std::ignore = core::bytes_parser(bformatter).parse(text);
+                FAIL();
+            }
+            catch (const core::bytes_parse_error& error)
+            {
+                ASSERT_EQ(error.position(), unit_position);
+            }
+        });
+}
+
+TEST(bytes_parser_tests, bytes_parser__unit_format_without_byte__exception)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    ASSERT_THROW(core::bytes_parser(unit_format("{1}")), std::invalid_argument);
+    ASSERT_THROW(core::bytes_parser(unit_format("{:z}")), std::format_error);
+}
+
+TEST(bytes_parser_tests, parse_stream_to__large_text__same_bytes)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const std::vector<std::byte> bytes = make_bytes(3'000'000);
+    for (const auto& format : { "{:0x}", "{1}:{0}" })
+    {
+        const core::bytes_formatter bformatter{ unit_format(format), nb_units_per_chunk(16) };
+        std::istringstream input_stream(bformatter.format_bytes(bytes));
+        std::ostringstream output_stream;
+        core::bytes_parser(bformatter).parse_stream_to(input_stream, output_stream);
+        ASSERT_EQ(output_stream.view().size(), bytes.size()) << format;
+        ASSERT_TRUE(std::ranges::equal(std::as_bytes(std::span(output_stream.view())), bytes)) << format;
+    }
+}
+
+TEST(bytes_parser_tests, parse_stream_to__invalid_text__exception)
+{
+    const std::vector<std::byte> bytes = make_bytes(1'000'000);
+    const core::bytes_formatter bformatter;
+    std::string text = bformatter.format_bytes(bytes);
+    const std::size_t position = text.size() - 10;
+    text[position] = '-';
+    std::istringstream input_stream(text);
+    std::ostringstream output_stream;
+    try
+    {
+        core::bytes_parser(bformatter).parse_stream_to(input_stream, output_stream);
+        FAIL();
+    }
+    catch (const core::bytes_parse_error& error)
+    {
+        ASSERT_LE(error.position(), position);
+        ASSERT_GE(error.position(), position - 4);
+    }
+}
+
+TEST(bytes_parser_tests, parse_bytes__kwargs__ok)
+{
+    using namespace core::bytes_formatter_kwargs;
+
+    const std::vector<std::byte> expected_res = { std::byte(1), std::byte(2), std::byte(3) };
+    ASSERT_EQ(core::parse_bytes("(1;2;3)", unit_format("{}"), unit_sep(";"), seq_beginning("("), seq_end(")")),
+              expected_res);
+    ASSERT_EQ(core::parse_bytes("[4:01 5:02 6:03]", 4, unit_format("{1}:{0:x}"), unit_sep(" ")), expected_res);
+}
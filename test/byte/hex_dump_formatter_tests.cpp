@@ -0,0 +1,206 @@
+#include "create_resource.hpp"
+#include "for_each_simd_level.hpp"
+#include <arba/core/byte/hex_dump_formatter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <span>
+#include <sstream>
+
+namespace
+{
+constexpr std::string_view sample_text("Hello, World!\nabc\0\1\377xyz", 23);
+
+std::span<const std::byte> sample_bytes()
+{
+    return std::as_bytes(std::span(sample_text));
+}
+} // namespace
+
+TEST(hex_dump_formatter_tests, format_bytes__xxd__ok)
+{
+    const core::hex_dump_formatter formatter(core::hex_dump_layout::xxd);
+    ASSERT_EQ(formatter.format_bytes(sample_bytes()),
+              "00000000: 4865 6c6c 6f2c 2057 6f72 6c64 210a 6162  Hello, World!.ab\n"
+              "00000010: 6300 01ff 7879 7a                        c...xyz\n");
+    ASSERT_EQ(formatter.format_bytes(sample_bytes().subspan(3), 3),
+              "00000003: 6c6f 2c20 576f 726c 6421 0a61 6263 0001  lo, World!.abc..\n"
+              "00000013: ff78 797a                                .xyz\n");
+    ASSERT_EQ(core::hex_dump_formatter(core::hex_dump_layout::xxd, 8).format_bytes(sample_bytes()),
+              "00000000: 4865 6c6c 6f2c 2057  Hello, W\n"
+              "00000008: 6f72 6c64 210a 6162  orld!.ab\n"
+              "00000010: 6300 01ff 7879 7a    c...xyz\n");
+    ASSERT_EQ(formatter.format_bytes({}), "");
+}
+
+TEST(hex_dump_formatter_tests, format_bytes__hexdump_canonical__ok)
+{
+    const core::hex_dump_formatter formatter(core::hex_dump_layout::hexdump_canonical);
+    ASSERT_EQ(formatter.format_bytes(sample_bytes()),
+              "00000000  48 65 6c 6c 6f 2c 20 57  6f 72 6c 64 21 0a 61 62  |Hello, World!.ab|\n"
+              "00000010  63 00 01 ff 78 79 7a"
+                  + std::string(30, ' ') + "|c...xyz|\n00000017\n");
+    ASSERT_EQ(formatter.format_bytes({}), "");
+}
+
+TEST(hex_dump_formatter_tests, format_bytes__od_hex__ok)
+{
+    const core::hex_dump_formatter formatter(core::hex_dump_layout::od_hex);
+    ASSERT_EQ(formatter.format_bytes(sample_bytes()), "0000000 6548 6c6c 2c6f 5720 726f 646c 0a21 6261\n"
+                                                      "0000020 0063 ff01 7978 007a\n"
+                                                      "0000027\n");
+    ASSERT_EQ(formatter.format_bytes(sample_bytes().subspan(3), 3),
+              "0000003 6f6c 202c 6f57 6c72 2164 610a 6362 0100\n"
+              "0000023 78ff 7a79\n"
+              "0000027\n");
+    ASSERT_EQ(formatter.format_bytes({}), "0000000\n");
+}
+
+TEST(hex_dump_formatter_tests, format_bytes__large_offset__wider_offset_column)
+{
+    const std::size_t offset = 0x1'2345'6780;
+    const std::string text = core::hex_dump_formatter().format_bytes(sample_bytes().first(2), offset);
+    ASSERT_EQ(text, "123456780: 4865" + std::string(37, ' ') + "He\n");
+}
+
+TEST(hex_dump_formatter_tests, hex_dump_formatter__invalid_nb_bytes_per_line__exception)
+{
+    ASSERT_THROW(core::hex_dump_formatter(core::hex_dump_layout::xxd, 0), std::invalid_argument);
+    ASSERT_THROW(core::hex_dump_formatter(core::hex_dump_layout::xxd, 7), std::invalid_argument);
+    ASSERT_THROW(core::hex_dump_formatter(core::hex_dump_layout::xxd, 258), std::invalid_argument);
+}
+
+TEST(hex_dump_formatter_tests, format_inputs__large_input__same_as_bytes)
+{
+    std::string input(200'003, '\0');
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<char>(i * 37 + i / 1000);
+    const std::filesystem::path input_fpath = ut::create_binary_resource("hex_dump_formatter_tests", "large.bin");
+    std::ofstream(input_fpath, std::ios::binary | std::ios::trunc).write(input.data(), std::ssize(input));
+    const std::span<const std::byte> bytes = std::as_bytes(std::span(input));
+
+    for (const core::hex_dump_layout layout :
+         { core::hex_dump_layout::xxd, core::hex_dump_layout::hexdump_canonical, core::hex_dump_layout::od_hex })
+    {
+        for (const uint32_t nb_bytes_per_line : { 16u, 32u, 6u })
+        {
+            const core::hex_dump_formatter formatter(layout, nb_bytes_per_line);
+            const std::string expected_res = formatter.format_bytes(bytes);
+            std::istringstream input_stream(input);
+            ASSERT_EQ(formatter.format_binary_stream(input_stream), expected_res);
+            FILE* input_file = std::fopen(input_fpath.generic_string().c_str(), "rb");
+            ASSERT_NE(input_file, nullptr);
+            ASSERT_EQ(formatter.format_binary_cstream(input_file), expected_res);
+            std::fclose(input_file);
+            ASSERT_EQ(formatter.format_binary_file(input_fpath), expected_res);
+            ASSERT_EQ(formatter.format_binary_file(input_fpath, 1000, 5000),
+                      formatter.format_bytes(bytes.subspan(1000, 5000), 1000));
+
+            std::ostringstream output_stream;
+            formatter.format_bytes_to(bytes, output_stream);
+            ASSERT_EQ(output_stream.str(), expected_res);
+            std::string iterator_output;
+            formatter.format_bytes_to(bytes, std::back_inserter(iterator_output));
+            ASSERT_EQ(iterator_output, expected_res);
+        }
+    }
+}
+
+TEST(hex_dump_formatter_tests, format_bytes__collapse_duplicate_lines__ok)
+{
+    const std::string zeros(64, '\0');
+    const std::span<const std::byte> bytes = std::as_bytes(std::span(zeros));
+    const std::string zero_line = "0000 0000 0000 0000 0000 0000 0000 0000  ................\n";
+
+    core::hex_dump_formatter xxd_formatter(core::hex_dump_layout::xxd);
+    xxd_formatter.set_collapse_duplicate_lines(true);
+    ASSERT_TRUE(xxd_formatter.collapse_duplicate_lines());
+    ASSERT_EQ(xxd_formatter.format_bytes(bytes), "00000000: " + zero_line + "*\n00000030: " + zero_line);
+    ASSERT_EQ(xxd_formatter.format_bytes(bytes.first(48)),
+              "00000000: " + zero_line + "00000010: " + zero_line + "00000020: " + zero_line);
+    ASSERT_EQ(xxd_formatter.format_bytes(bytes.first(40)),
+              "00000000: " + zero_line + "00000010: " + zero_line + "00000020: 0000 0000 0000 0000"
+                  + std::string(22, ' ') + "........\n");
+
+    // xxd -a only collapses zero lines.
+    const std::string letters(80, 'A');
+    const std::string letter_line = "4141 4141 4141 4141 4141 4141 4141 4141  AAAAAAAAAAAAAAAA\n";
+    ASSERT_EQ(xxd_formatter.format_bytes(std::as_bytes(std::span(letters))),
+              "00000000: " + letter_line + "00000010: " + letter_line + "00000020: " + letter_line + "00000030: "
+                  + letter_line + "00000040: " + letter_line);
+
+    core::hex_dump_formatter od_formatter(core::hex_dump_layout::od_hex);
+    od_formatter.set_collapse_duplicate_lines(true);
+    ASSERT_EQ(od_formatter.format_bytes(bytes.first(32)),
+              "0000000 0000 0000 0000 0000 0000 0000 0000 0000\n*\n0000040\n");
+    std::string input = zeros + "ab";
+    ASSERT_EQ(od_formatter.format_bytes(std::as_bytes(std::span(input))),
+              "0000000 0000 0000 0000 0000 0000 0000 0000 0000\n*\n0000100 6261\n0000102\n");
+
+    core::hex_dump_formatter hexdump_formatter(core::hex_dump_layout::hexdump_canonical);
+    hexdump_formatter.set_collapse_duplicate_lines(true);
+    ASSERT_EQ(hexdump_formatter.format_bytes(bytes),
+              "00000000  00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00  |................|\n*\n00000040\n");
+    ASSERT_EQ(hexdump_formatter.format_bytes(std::as_bytes(std::span(letters))),
+              "00000000  41 41 41 41 41 41 41 41  41 41 41 41 41 41 41 41  |AAAAAAAAAAAAAAAA|\n*\n00000050\n");
+}
+
+TEST(hex_dump_formatter_tests, format_inputs__collapse_duplicate_lines__same_as_bytes)
+{
+    // Runs of duplicate lines crossing the read blocks, and a partial last line.
+    std::string input(300'005, '\0');
+    for (std::size_t i = 0; i < input.size(); ++i)
+        if ((i / 50'000) % 2 == 1 || i % 997 == 0)
+            input[i] = static_cast<char>(i * 37);
+    const std::filesystem::path input_fpath =
+        ut::create_binary_resource("hex_dump_formatter_tests", "duplicate_lines.bin");
+    std::ofstream(input_fpath, std::ios::binary | std::ios::trunc).write(input.data(), std::ssize(input));
+    const std::span<const std::byte> bytes = std::as_bytes(std::span(input));
+
+    for (const core::hex_dump_layout layout :
+         { core::hex_dump_layout::xxd, core::hex_dump_layout::hexdump_canonical, core::hex_dump_layout::od_hex })
+    {
+        for (const uint32_t nb_bytes_per_line : { 16u, 6u })
+        {
+            core::hex_dump_formatter formatter(layout, nb_bytes_per_line);
+            formatter.set_collapse_duplicate_lines(true);
+            const std::string expected_res = formatter.format_bytes(bytes);
+            ASSERT_NE(expected_res.find("*\n"), std::string::npos);
+            ut::for_each_simd_level(
+                [&]
+                {
+                    ASSERT_EQ(formatter.format_bytes(bytes), expected_res);
+                    std::istringstream input_stream(input);
+                    ASSERT_EQ(formatter.format_binary_stream(input_stream), expected_res);
+                    ASSERT_EQ(formatter.format_binary_file(input_fpath), expected_res);
+                });
+        }
+    }
+}
+
+TEST(hex_dump_formatter_tests, format_binary_file__sparse_file__same_as_bytes)
+{
+    const std::filesystem::path input_fpath = ut::create_binary_resource("hex_dump_formatter_tests", "sparse.bin");
+    {
+        std::ofstream output(input_fpath, std::ios::binary | std::ios::trunc);
+        output.write("head", 4);
+        output.seekp(3 << 20);
+        output.write("middle", 6);
+        output.seekp(8 << 20);
+        output.write("tail", 4);
+    }
+    std::string input(std::filesystem::file_size(input_fpath), '\0');
+    std::ifstream(input_fpath, std::ios::binary).read(input.data(), std::ssize(input));
+    const std::span<const std::byte> bytes = std::as_bytes(std::span(input));
+
+    for (const core::hex_dump_layout layout :
+         { core::hex_dump_layout::xxd, core::hex_dump_layout::hexdump_canonical, core::hex_dump_layout::od_hex })
+    {
+        core::hex_dump_formatter formatter(layout);
+        formatter.set_collapse_duplicate_lines(true);
+        ASSERT_EQ(formatter.format_binary_file(input_fpath), formatter.format_bytes(bytes));
+        ASSERT_EQ(formatter.format_binary_file(input_fpath, 5000, 5 << 20),
+                  formatter.format_bytes(bytes.subspan(5000, 5 << 20), 5000));
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <arba/core/sbrm/sbrm.hpp>
+#include <arba/core/simd/cpu_features.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace ut
+{
+// Calls function with each SIMD level forced, from scalar to the detected level, and stops at the first fatal failure.
+// The automatic level is restored whatever the way out.
+template <class Function>
+void for_each_simd_level(Function function)
+{
+    core::sbrm sentry(&core::reset_simd_level);
+    for (std::size_t level = 0; level <= static_cast<std::size_t>(core::detected_simd_level()); ++level)
+    {
+        SCOPED_TRACE(core::to_string_view(static_cast<core::simd_level>(level)));
+        core::force_simd_level(static_cast<core::simd_level>(level));
+        function();
+        if (::testing::Test::HasFatalFailure())
+            return;
+    }
+}
+} // namespace ut
@@ -0,0 +1,88 @@
+#include <arba/core/bit/htow.hpp>
+#include <arba/core/range/byte_swap_view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <numeric>
+#include <vector>
+
+TEST(byte_swap_view_tests, byte_swapped__vector__ok)
+{
+    const std::vector<uint32_t> values = { 0x11223344, 0x55667788, 0x99aabbcc };
+
+    auto swapped_values = values | core::views::byte_swapped;
+    using view_t = decltype(swapped_values);
+    static_assert(std::ranges::random_access_range<view_t>);
+    static_assert(std::ranges::sized_range<view_t>);
+    static_assert(std::ranges::common_range<view_t>);
+    static_assert(std::same_as<std::ranges::range_value_t<view_t>, uint32_t>);
+
+    ASSERT_EQ(swapped_values.size(), 3);
+    ASSERT_EQ(swapped_values[0], 0x44332211u);
+    ASSERT_EQ(swapped_values[2], 0xccbbaa99u);
+    ASSERT_EQ(*(swapped_values.end() - 2), 0x88776655u);
+    ASSERT_EQ(swapped_values.end() - swapped_values.begin(), 3);
+    ASSERT_EQ(swapped_values.base().data(), values.data());
+    ASSERT_TRUE(std::ranges::equal(core::views::byte_swapped(swapped_values.base()), swapped_values));
+}
+
+TEST(byte_swap_view_tests, wtoh__binary_search__ok)
+{
+    std::vector<uint64_t> timestamps(1000);
+    std::iota(timestamps.begin(), timestamps.end(), uint64_t(1'700'000'000));
+    std::vector<uint64_t> world_timestamps(timestamps.size());
+    core::htow(std::span<const uint64_t>(timestamps), std::span(world_timestamps));
+
+    auto host_timestamps = core::views::wtoh(world_timestamps);
+    auto iter = std::ranges::lower_bound(host_timestamps, uint64_t(1'700'000'500));
+    ASSERT_EQ(iter - host_timestamps.begin(), 500);
+    ASSERT_EQ(*iter, 1'700'000'500u);
+    ASSERT_EQ(*std::ranges::find_if(host_timestamps, [](uint64_t value) { return value > 1'700'000'998; }),
+              1'700'000'999u);
+
+    auto world_view = timestamps | core::views::htow;
+    ASSERT_TRUE(std::ranges::equal(world_view, world_timestamps));
+}
+
+TEST(byte_swap_view_tests, copy_to__contiguous__ok)
+{
+    std::vector<uint16_t> values(100);
+    std::iota(values.begin(), values.end(), uint16_t(0x100));
+    auto swapped_values = core::views::byte_swapped(values);
+
+    std::vector<uint16_t> output(values.size());
+    swapped_values.copy_to(output);
+    ASSERT_TRUE(std::ranges::equal(output, swapped_values));
+    ASSERT_EQ(swapped_values.to_vector(), output);
+
+    std::vector<uint16_t> small_output(values.size() - 1);
+    ASSERT_THROW(swapped_values.copy_to(small_output), std::length_error);
+}
+
+TEST(byte_swap_view_tests, copy_to__list__ok)
+{
+    const std::list<int32_t> values = { -4097, 1, 2 };
+    auto swapped_values = core::views::byte_swapped(values);
+    static_assert(std::ranges::bidirectional_range<decltype(swapped_values)>);
+    static_assert(!std::ranges::random_access_range<decltype(swapped_values)>);
+
+    const std::vector<int32_t> expected_values = { core::byte_swap(int32_t(-4097)), core::byte_swap(int32_t(1)),
+                                                   core::byte_swap(int32_t(2)) };
+    ASSERT_EQ(swapped_values.to_vector(), expected_values);
+    ASSERT_EQ(*std::ranges::prev(swapped_values.end()), core::byte_swap(int32_t(2)));
+
+    std::vector<int32_t> small_output(2);
+    ASSERT_THROW(swapped_values.copy_to(small_output), std::length_error);
+}
+
+TEST(byte_swap_view_tests, byte_swapped__non_common_range__ok)
+{
+    const std::vector<uint16_t> values = { 0x0102, 0x0304, 0x0506, 0x0708 };
+    auto swapped_values = values | std::views::take_while([](uint16_t value) { return value < 0x0500; })
+                          | core::views::byte_swapped;
+    static_assert(!std::ranges::common_range<decltype(swapped_values)>);
+    ASSERT_EQ(swapped_values.to_vector(), (std::vector<uint16_t>{ 0x0201, 0x0403 }));
+}
@@ -0,0 +1,55 @@
+#include <arba/core/simd/cpu_features.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+TEST(cpu_features_tests, level__no_feature__scalar)
+{
+    core::cpu_features features;
+    ASSERT_EQ(features.level(), core::simd_level::scalar);
+}
+
+TEST(cpu_features_tests, level__missing_feature__previous_level)
+{
+    core::cpu_features features{ .sse2 = true, .ssse3 = true, .sse4_1 = true, .sse4_2 = true, .popcnt = true,
+                                 .avx2 = true, .bmi1 = true };
+    ASSERT_EQ(features.level(), core::simd_level::sse4_2);
+    features.bmi2 = true;
+    ASSERT_EQ(features.level(), core::simd_level::avx2);
+    features.avx512f = features.avx512bw = features.avx512dq = features.avx512vl = true;
+    ASSERT_EQ(features.level(), core::simd_level::avx512);
+}
+
+TEST(cpu_features_tests, to_simd_level__valid_name__ok)
+{
+    for (std::size_t i = 0; i < core::nb_simd_levels; ++i)
+    {
+        const core::simd_level level = static_cast<core::simd_level>(i);
+        ASSERT_EQ(core::to_simd_level(core::to_string_view(level)), level);
+    }
+}
+
+TEST(cpu_features_tests, to_simd_level__invalid_name__nullopt)
+{
+    ASSERT_EQ(core::to_simd_level("avx3"), std::nullopt);
+}
+
+TEST(cpu_features_tests, detected_simd_level__x86_64__at_least_sse2)
+{
+#if defined(ARBA_CORE_SIMD_X86) && (defined(__x86_64__) || defined(_M_X64))
+    ASSERT_GE(core::detected_simd_level(), core::simd_level::sse2);
+#else
+    GTEST_SKIP();
+#endif
+}
+
+TEST(cpu_features_tests, force_simd_level__lower_level__ok)
+{
+    core::force_simd_level(core::simd_level::scalar);
+    ASSERT_EQ(core::active_simd_level(), core::simd_level::scalar);
+    core::force_simd_level(core::simd_level::avx512);
+    ASSERT_EQ(core::active_simd_level(), core::detected_simd_level());
+    core::reset_simd_level();
+    ASSERT_LE(core::active_simd_level(), core::detected_simd_level());
+}
@@ -0,0 +1,49 @@
+#include <arba/core/simd/simd_dispatcher.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+namespace
+{
+int scalar_kernel(int value)
+{
+    return value;
+}
+
+int sse2_kernel(int value)
+{
+    return value + 2;
+}
+
+int avx2_kernel(int value)
+{
+    return value + 4;
+}
+
+inline constexpr auto kernel =
+    core::simd_dispatcher(&scalar_kernel).with(core::simd_level::sse2, &sse2_kernel).with(core::simd_level::avx2,
+                                                                                         &avx2_kernel);
+} // namespace
+
+TEST(simd_dispatcher_tests, variant__registered_levels__best_lower_or_equal_variant)
+{
+#if defined(ARBA_CORE_SIMD_X86)
+    static_assert(kernel.variant(core::simd_level::scalar) == &scalar_kernel);
+    static_assert(kernel.variant(core::simd_level::sse2) == &sse2_kernel);
+    static_assert(kernel.variant(core::simd_level::sse4_2) == &sse2_kernel);
+    static_assert(kernel.variant(core::simd_level::avx2) == &avx2_kernel);
+    static_assert(kernel.variant(core::simd_level::avx512) == &avx2_kernel);
+#else
+    static_assert(kernel.variant(core::simd_level::avx512) == &scalar_kernel);
+#endif
+}
+
+TEST(simd_dispatcher_tests, call__forced_level__ok)
+{
+    core::force_simd_level(core::simd_level::scalar);
+    ASSERT_EQ(kernel(10), 10);
+    core::force_simd_level(core::simd_level::avx2);
+    ASSERT_EQ(kernel(10), kernel.variant(core::detected_simd_level())(10));
+    core::reset_simd_level();
+}